@@ -0,0 +1,240 @@
+//!
+//! @brief   Transposition between array of structs (AoS) and struct of arrays (SoA).
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! The kernels are driven by the field offsets and sizes of struct_traits:
+//!   1) 4- and 8-byte fields are gathered (AoS->SoA) by AVX2/AVX-512 and scattered (SoA->AoS) by AVX-512,
+//!   2) other fields are copied by scalar loops with compile-time size and stride.
+//! The instruction set is selected at runtime, SIMD kernels are only built by GCC/Clang on x86.
+//!
+
+#pragma once
+#include <climits>  // INT_MAX
+#include <cstddef>  // byte
+#include <cstring>  // memcpy
+#include <span>
+
+#include "struct_traits.hpp"
+#include "soa_vector.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ZHB_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define ZHB_SIMD_X86 0
+#endif
+
+namespace zhb {
+
+    //! @brief instruction set used by the kernels.
+    enum class simd_level { scalar, avx2, avx512 };
+
+    //! @brief Get the best instruction set supported by the running CPU.
+    inline simd_level best_simd_level()noexcept
+    {
+#if ZHB_SIMD_X86
+        static const simd_level level = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))return simd_level::avx512;
+            if (__builtin_cpu_supports("avx2"))   return simd_level::avx2;
+            return simd_level::scalar;
+        }();
+        return level;
+#else
+        return simd_level::scalar;
+#endif
+    }
+
+    namespace detail
+    {
+        //! @brief number of bytes of AoS records transposed at once, keep the block in L1 cache.
+        inline constexpr std::size_t aos_soa_block_bytes_ = 16 * 1024;
+
+        template<std::size_t Stride, std::size_t Size>
+        inline void gather_scalar_(const std::byte* src, std::size_t n, std::byte* dst)noexcept
+        {
+            for (std::size_t k = 0; k < n; ++k)
+                std::memcpy(dst + k * Size, src + k * Stride, Size);
+        }
+
+        template<std::size_t Stride, std::size_t Size>
+        inline void scatter_scalar_(const std::byte* src, std::size_t n, std::byte* dst)noexcept
+        {
+            for (std::size_t k = 0; k < n; ++k)
+                std::memcpy(dst + k * Stride, src + k * Size, Size);
+        }
+
+#if ZHB_SIMD_X86
+        template<std::size_t Stride, std::size_t Size>
+        __attribute__((target("avx2")))
+        void gather_avx2_(const std::byte* src, std::size_t n, std::byte* dst)noexcept
+        {
+            constexpr int s = static_cast<int>(Stride);
+            std::size_t k = 0;
+            if constexpr (Size == 4) {
+                const __m256i vindex = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+                for (; k + 8 <= n; k += 8) {
+                    const __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src + k * Stride), vindex, 1);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k * Size), v);
+                }
+            }
+            else {
+                const __m128i vindex = _mm_setr_epi32(0, s, 2 * s, 3 * s);
+                for (; k + 4 <= n; k += 4) {
+                    const __m256i v = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(src + k * Stride), vindex, 1);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k * Size), v);
+                }
+            }
+            gather_scalar_<Stride, Size>(src + k * Stride, n - k, dst + k * Size);
+        }
+
+        template<std::size_t Stride, std::size_t Size>
+        __attribute__((target("avx512f")))
+        void gather_avx512_(const std::byte* src, std::size_t n, std::byte* dst)noexcept
+        {
+            constexpr int s = static_cast<int>(Stride);
+            std::size_t k = 0;
+            if constexpr (Size == 4) {
+                const __m512i vindex = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(s));
+                for (; k + 16 <= n; k += 16) {
+                    const __m512i v = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, vindex, src + k * Stride, 1);
+                    _mm512_storeu_si512(dst + k * Size, v);
+                }
+            }
+            else {
+                const __m256i vindex = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+                for (; k + 8 <= n; k += 8) {
+                    const __m512i v = _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), 0xFF, vindex, src + k * Stride, 1);
+                    _mm512_storeu_si512(dst + k * Size, v);
+                }
+            }
+            gather_scalar_<Stride, Size>(src + k * Stride, n - k, dst + k * Size);
+        }
+
+        template<std::size_t Stride, std::size_t Size>
+        __attribute__((target("avx512f")))
+        void scatter_avx512_(const std::byte* src, std::size_t n, std::byte* dst)noexcept
+        {
+            constexpr int s = static_cast<int>(Stride);
+            std::size_t k = 0;
+            if constexpr (Size == 4) {
+                const __m512i vindex = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(s));
+                for (; k + 16 <= n; k += 16) {
+                    const __m512i v = _mm512_loadu_si512(src + k * Size);
+                    _mm512_i32scatter_epi32(dst + k * Stride, vindex, v, 1);
+                }
+            }
+            else {
+                const __m256i vindex = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+                for (; k + 8 <= n; k += 8) {
+                    const __m512i v = _mm512_loadu_si512(src + k * Size);
+                    _mm512_i32scatter_epi64(dst + k * Stride, vindex, v, 1);
+                }
+            }
+            scatter_scalar_<Stride, Size>(src + k * Size, n - k, dst + k * Stride);
+        }
+#endif
+
+        //! @brief whether or not the field can be transposed by SIMD gather/scatter.
+        template<std::size_t Stride, std::size_t Size>
+        inline constexpr bool simd_transposable_ = (Size == 4 || Size == 8) && Stride * 16 <= INT_MAX;
+
+        //! @brief copy \n strided elements to contiguous memory.
+        template<std::size_t Stride, std::size_t Size>
+        inline void gather_(const std::byte* src, std::size_t n, std::byte* dst, simd_level level)noexcept
+        {
+#if ZHB_SIMD_X86
+            if constexpr (simd_transposable_<Stride, Size>) {
+                if (level == simd_level::avx512)return gather_avx512_<Stride, Size>(src, n, dst);
+                if (level == simd_level::avx2)  return gather_avx2_<Stride, Size>(src, n, dst);
+            }
+#endif
+            gather_scalar_<Stride, Size>(src, n, dst);
+        }
+
+        //! @brief copy \n contiguous elements to strided memory.
+        template<std::size_t Stride, std::size_t Size>
+        inline void scatter_(const std::byte* src, std::size_t n, std::byte* dst, simd_level level)noexcept
+        {
+#if ZHB_SIMD_X86
+            if constexpr (simd_transposable_<Stride, Size>) {
+                if (level == simd_level::avx512)return scatter_avx512_<Stride, Size>(src, n, dst);
+            }
+#endif
+            scatter_scalar_<Stride, Size>(src, n, dst);
+        }
+
+        template<aggregate T>
+        inline constexpr std::size_t aos_soa_block_ = sizeof(T) >= aos_soa_block_bytes_ ? 1 : aos_soa_block_bytes_ / sizeof(T);
+
+        template<aggregate T, std::size_t... I>
+        inline void aos_to_soa_(const std::byte* src, std::size_t n, std::byte* const* columns, simd_level level, std::index_sequence<I...>)noexcept
+        {
+            for (std::size_t k = 0; k < n; k += aos_soa_block_<T>) {
+                const std::size_t m = n - k < aos_soa_block_<T> ? n - k : aos_soa_block_<T>;
+                (gather_<sizeof(T), sizes_v<T>[I]>(src + k * sizeof(T) + offsets_v<T>[I], m, columns[I] + k * sizes_v<T>[I], level), ...);
+            }
+        }
+
+        template<aggregate T, std::size_t... I>
+        inline void soa_to_aos_(const std::byte* const* columns, std::size_t n, std::byte* dst, simd_level level, std::index_sequence<I...>)noexcept
+        {
+            for (std::size_t k = 0; k < n; k += aos_soa_block_<T>) {
+                const std::size_t m = n - k < aos_soa_block_<T> ? n - k : aos_soa_block_<T>;
+                (scatter_<sizeof(T), sizes_v<T>[I]>(columns[I] + k * sizes_v<T>[I], m, dst + k * sizeof(T) + offsets_v<T>[I], level), ...);
+            }
+        }
+    }
+
+    //! @brief pointers to the columns, the I-th one points to elements of field_type_t<T, I>.
+    template<aggregate T> using column_pointers     = std::array<void*,       num_fields_v<T>>;
+    //! @brief pointers to the columns, the I-th one points to elements of field_type_t<T, I>.
+    template<aggregate T> using const_column_pointers = std::array<const void*, num_fields_v<T>>;
+
+    //! @brief Copy \n records into the columns.
+    template<aggregate T>
+    inline void aos_to_soa(const T* records, std::size_t n, const column_pointers<T>& columns, simd_level level = best_simd_level())noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable struct is supported!");
+
+        std::array<std::byte*, num_fields_v<T>> dst;
+        for (std::size_t i = 0; i < dst.size(); ++i)
+            dst[i] = static_cast<std::byte*>(columns[i]);
+        detail::aos_to_soa_<T>(reinterpret_cast<const std::byte*>(records), n, dst.data(), level, std::make_index_sequence<num_fields_v<T>>{});
+    }
+
+    //! @brief Copy \n records from the columns.
+    template<aggregate T>
+    inline void soa_to_aos(const const_column_pointers<T>& columns, std::size_t n, T* records, simd_level level = best_simd_level())noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable struct is supported!");
+
+        std::array<const std::byte*, num_fields_v<T>> src;
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = static_cast<const std::byte*>(columns[i]);
+        detail::soa_to_aos_<T>(src.data(), n, reinterpret_cast<std::byte*>(records), level, std::make_index_sequence<num_fields_v<T>>{});
+    }
+
+    //! @brief Copy all records into soa_vector, which is resized to the number of records.
+    template<aggregate T>
+    inline void aos_to_soa(std::type_identity_t<std::span<const T>> records, soa_vector<T>& columns, simd_level level = best_simd_level())
+    {
+        columns.clear(); // the old records are overwritten, they are not copied if the storage grows
+        columns.resize_for_overwrite(records.size());
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            aos_to_soa<T>(records.data(), records.size(), column_pointers<T>{ columns.template column<I>().data()... }, level);
+        }(std::make_index_sequence<num_fields_v<T>>{});
+    }
+
+    //! @brief Copy all records from soa_vector, \records should have the same size as \columns.
+    template<aggregate T>
+    inline void soa_to_aos(const soa_vector<T>& columns, std::type_identity_t<std::span<T>> records, simd_level level = best_simd_level())noexcept
+    {
+        assert(records.size() == columns.size());
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            soa_to_aos<T>(const_column_pointers<T>{ columns.template column<I>().data()... }, columns.size(), records.data(), level);
+        }(std::make_index_sequence<num_fields_v<T>>{});
+    }
+}
@@ -0,0 +1,66 @@
+//!
+//! @brief   Bandwidth of AoS<->SoA transposition for several field layouts.
+//!
+//! build:
+//!   g++ -std=c++20 -O2 -DNDEBUG -I.. aos_soa.cpp -o aos_soa
+//!
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../aos_soa.hpp"
+
+// 4 x 4-byte fields, no padding
+struct Vec4f { float x, y, z, w; };
+
+// 8 x 8-byte fields, no padding
+struct Vec8d { double v0, v1, v2, v3, v4, v5, v6, v7; };
+
+// mixed fields with padding
+struct Mixed { double a; int b; char c; long long d; float e; short f; };
+
+// array fields, copied by scalar loops
+struct Arrays { int a[3]; double b; char c[5]; float d[2]; };
+
+template<typename T>
+void run(const char* name, std::size_t n)
+{
+    std::vector<T> records(n), back(n);
+    for (std::size_t i = 0; i < n; ++i)
+        zhb::struct_traits<T>::visit(records[i], [i](auto& val) { std::memset(&val, int(i), sizeof(val)); });
+
+    zhb::soa_vector<T> columns;
+    constexpr int nrepeat = 20;
+    const double gbytes = double(n) * sizeof(T) * nrepeat / 1e9;
+
+    const char* names[] = { "scalar", "avx2", "avx512" };
+    for (auto level : { zhb::simd_level::scalar, zhb::simd_level::avx2, zhb::simd_level::avx512 }) {
+        if (level > zhb::best_simd_level())continue;
+
+        zhb::aos_to_soa<T>(records, columns, level); // warm up
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int k = 0; k < nrepeat; ++k)
+            zhb::aos_to_soa<T>(records, columns, level);
+        auto t1 = std::chrono::steady_clock::now();
+        for (int k = 0; k < nrepeat; ++k)
+            zhb::soa_to_aos<T>(columns, back, level);
+        auto t2 = std::chrono::steady_clock::now();
+
+        std::printf("%-8s %-7s aos_to_soa %7.2f GB/s, soa_to_aos %7.2f GB/s\n", name, names[int(level)],
+            gbytes / std::chrono::duration<double>(t1 - t0).count(),
+            gbytes / std::chrono::duration<double>(t2 - t1).count());
+    }
+}
+
+int main()
+{
+    constexpr std::size_t nbytes = 64 << 20;
+
+    run<Vec4f >("Vec4f",  nbytes / sizeof(Vec4f));
+    run<Vec8d >("Vec8d",  nbytes / sizeof(Vec8d));
+    run<Mixed >("Mixed",  nbytes / sizeof(Mixed));
+    run<Arrays>("Arrays", nbytes / sizeof(Arrays));
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+#
+# Compile-time benchmark of zhb::num_fields_v.
+#
+# Generates aggregates with 1..MAX fields, then for every requested size
+# records the front-end time (-fsyntax-only) and the minimal recursion
+# depth (-fconstexpr-depth) needed to count the fields: the field counter
+# recurses through consteval calls, one template instantiation per level.
+# A last row compiles all the structs in ONE translation unit.
+#
+# usage:
+#   python3 bench/compile_time.py [--cxx g++] [--max 256] [--step 32] [--csv out.csv]
+#
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def make_struct(n):
+    fields = ' '.join('int f%d;' % i for i in range(n))
+    return 'struct S%d { %s };\n' \
+           'static_assert(zhb::num_fields_v<S%d> == %d);\n' % (n, fields, n, n)
+
+
+def make_source(sizes):
+    return '#include "struct_traits.hpp"\n' + ''.join(make_struct(n) for n in sizes)
+
+
+def compile_ok(cxx, src, depth=None):
+    cmd = [cxx, '-std=c++20', '-fsyntax-only', '-I', ROOT, src]
+    if depth is not None:
+        cmd.append('-fconstexpr-depth=%d' % depth)
+    t0 = time.perf_counter()
+    res = subprocess.run(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    return res.returncode == 0, time.perf_counter() - t0
+
+
+def min_depth(cxx, src):
+    lo, hi = 1, 1024
+    if not compile_ok(cxx, src, hi)[0]:
+        return -1
+    while lo < hi:
+        mid = (lo + hi) // 2
+        if compile_ok(cxx, src, mid)[0]:
+            hi = mid
+        else:
+            lo = mid + 1
+    return lo
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument('--cxx', default=os.environ.get('CXX', 'g++'))
+    ap.add_argument('--max', type=int, default=256)
+    ap.add_argument('--step', type=int, default=32)
+    ap.add_argument('--repeat', type=int, default=3)
+    ap.add_argument('--csv', default=None)
+    args = ap.parse_args()
+
+    sizes = sorted({1} | set(range(args.step, args.max + 1, args.step)))
+    rows = [('fields', 'seconds', 'min_depth')]
+
+    with tempfile.TemporaryDirectory() as tmp:
+        src = os.path.join(tmp, 'bench.cpp')
+        for n in sizes:
+            with open(src, 'w') as f:
+                f.write(make_source([n]))
+            ok, _ = compile_ok(args.cxx, src)
+            if not ok:
+                sys.exit('failed to compile struct with %d fields' % n)
+            t = min(compile_ok(args.cxx, src)[1] for _ in range(args.repeat))
+            rows.append((str(n), '%.3f' % t, str(min_depth(args.cxx, src))))
+
+        with open(src, 'w') as f:
+            f.write(make_source(range(1, args.max + 1)))
+        ok, t = compile_ok(args.cxx, src)
+        if not ok:
+            sys.exit('failed to compile structs with 1..%d fields' % args.max)
+        rows.append(('1..%d' % args.max, '%.3f' % t, '-'))
+
+    text = '\n'.join(','.join(r) for r in rows) + '\n'
+    sys.stdout.write(text)
+    if args.csv:
+        with open(args.csv, 'w') as f:
+            f.write(text)
+
+
+if __name__ == '__main__':
+    main()
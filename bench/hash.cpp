@@ -0,0 +1,99 @@
+//!
+//! @brief   Benchmark of zhb::hash and zhb::hash_many against hand-written per-field hash-combine.
+//!
+//! build:
+//!   g++ -std=c++20 -O2 -DNDEBUG -I.. hash.cpp -o hash
+//!
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+#include "../hash.hpp"
+
+// a struct having unique object representation
+struct K
+{
+    int       id;
+    unsigned  version;
+    long long key;
+    int       shard;
+    int       flags;
+};
+
+// a struct with padding and floating point
+struct P
+{
+    char   c;
+    double x;
+    int    n;
+    short  s;
+    float  y;
+};
+
+inline void hash_combine(std::size_t& seed, std::size_t h)
+{
+    seed ^= h + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+struct K_hash
+{
+    std::size_t operator()(const K& k)const noexcept
+    {
+        std::size_t seed = 0;
+        hash_combine(seed, std::hash<int>{}(k.id));
+        hash_combine(seed, std::hash<unsigned>{}(k.version));
+        hash_combine(seed, std::hash<long long>{}(k.key));
+        hash_combine(seed, std::hash<int>{}(k.shard));
+        hash_combine(seed, std::hash<int>{}(k.flags));
+        return seed;
+    }
+};
+
+struct P_hash
+{
+    std::size_t operator()(const P& p)const noexcept
+    {
+        std::size_t seed = 0;
+        hash_combine(seed, std::hash<char>{}(p.c));
+        hash_combine(seed, std::hash<double>{}(p.x));
+        hash_combine(seed, std::hash<int>{}(p.n));
+        hash_combine(seed, std::hash<short>{}(p.s));
+        hash_combine(seed, std::hash<float>{}(p.y));
+        return seed;
+    }
+};
+
+template<typename Func>
+void run(const char* name, std::size_t n, Func&& func)
+{
+    constexpr int nrepeat = 20;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < nrepeat; ++k)func();
+    auto t1 = std::chrono::steady_clock::now();
+    std::printf("%-24s %7.3f ns/record\n", name, std::chrono::duration<double, std::nano>(t1 - t0).count() / (nrepeat * n));
+}
+
+template<typename T, typename Hand>
+void bench(const char* name, std::size_t n)
+{
+    std::vector<T> records(n);
+    for (std::size_t i = 0; i < n; ++i)
+        zhb::struct_traits<T>::visit(records[i], [i](auto& val) { val = static_cast<std::remove_reference_t<decltype(val)>>(i * 7 + 1); });
+    std::vector<std::uint64_t> out(n);
+
+    std::printf("%s (sizeof=%zu):\n", name, sizeof(T));
+    run("  hand-written combine", n, [&] { for (std::size_t i = 0; i < n; ++i)out[i] = Hand{}(records[i]); });
+    run("  zhb::hash", n, [&] { for (std::size_t i = 0; i < n; ++i)out[i] = zhb::hash<T>{}(records[i]); });
+    run("  zhb::hash_many", n, [&] { zhb::hash_many<T>(records, out.data()); });
+}
+
+int main()
+{
+    constexpr std::size_t n = 1 << 16;
+
+    bench<K, K_hash>("K, unique representation", n);
+    bench<P, P_hash>("P, padding and floating point", n);
+
+    return 0;
+}
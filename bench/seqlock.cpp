@@ -0,0 +1,93 @@
+//!
+//! @brief   Benchmark of zhb::seqlock against std::mutex: reads per second with 1..N reader threads and one writer.
+//!
+//! build:
+//!   g++ -std=c++20 -O2 -DNDEBUG -I.. seqlock.cpp -o seqlock -pthread
+//!
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib> // atoi
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../seqlock.hpp"
+
+// a market-state like struct
+struct State
+{
+    long   sequence;
+    double bid[4];
+    double ask[4];
+    int    bid_size[4];
+    int    ask_size[4];
+    char   status;
+};
+
+//! @brief run \nreader threads calling \read for \seconds while one thread calls \write, return reads per second.
+template<typename Read, typename Write>
+double run(int nreader, double seconds, Read&& read, Write&& write)
+{
+    std::atomic<bool> stop{ false };
+    std::atomic<long> total{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < nreader; ++r)
+        threads.emplace_back([&] {
+            long n = 0;
+            double sink = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                sink += read();
+                ++n;
+            }
+            total += n + (sink == -1.0); // keep sink alive
+            });
+    threads.emplace_back([&] {
+        for (long v = 0; !stop.load(std::memory_order_relaxed); ++v) {
+            write(v);
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+        }
+        });
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto& t : threads)t.join();
+    return total / seconds;
+}
+
+int main(int argc, char** argv)
+{
+    const int max_readers = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    const double seconds  = 0.5;
+
+    zhb::seqlock<State> seq;
+    State locked{};
+    std::mutex mutex;
+
+    const auto make = [](long v) {
+        State s{};
+        s.sequence = v;
+        for (int k = 0; k < 4; ++k) {
+            s.bid[k] = v - k;
+            s.ask[k] = v + k;
+        }
+        return s;
+        };
+
+    std::printf("readers   mutex (Mreads/s)   seqlock load   seqlock read<0,1>\n");
+    for (int n = 1; n <= max_readers; n *= 2) {
+        const double t_mutex = run(n, seconds,
+            [&] { std::lock_guard lock(mutex); return locked.bid[0]; },
+            [&](long v) { const State s = make(v); std::lock_guard lock(mutex); locked = s; });
+        const double t_load = run(n, seconds,
+            [&] { return seq.load().bid[0]; },
+            [&](long v) { seq.store(make(v)); });
+        const double t_read = run(n, seconds,
+            [&] { return seq.read<0, 1>().bid[0]; },
+            [&](long v) { seq.store(make(v)); });
+        std::printf("%7d   %16.1f   %12.1f   %17.1f\n", n, t_mutex / 1e6, t_load / 1e6, t_read / 1e6);
+    }
+
+    return 0;
+}
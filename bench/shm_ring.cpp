@@ -0,0 +1,115 @@
+//!
+//! @brief   Benchmark of zhb::shm_ring between two processes: streaming bandwidth and round-trip latency.
+//!
+//! build:
+//!   g++ -std=c++20 -O2 -DNDEBUG -I.. shm_ring.cpp -o shm_ring
+//!
+//! The producer and the consumer spin, so they should run on different cores,
+//! they yield after spinning for a while to make progress on one core too.
+//!
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib> // atol
+#include <thread>  // yield
+#include <vector>
+#include <sys/wait.h> // waitpid
+#include <unistd.h>   // fork
+#include "../shm_ring.hpp"
+
+struct Record
+{
+    long   id;
+    double x, y, z;
+    float  mass;
+    int    flags;
+};
+
+using clock_type = std::chrono::steady_clock;
+
+//! @brief yield after spinning 1000 times without progress.
+inline void backoff(std::size_t progress, int& spins)
+{
+    if (progress > 0)spins = 0;
+    else if (++spins == 1000) {
+        spins = 0;
+        std::this_thread::yield();
+    }
+}
+
+//! @brief publish all the records, spin if the ring is full.
+template<typename T>
+void publish_all(zhb::shm_ring<T>& ring, std::span<const T> records)
+{
+    for (int spins = 0; !records.empty();) {
+        const std::size_t n = ring.publish(records);
+        records = records.subspan(n);
+        backoff(n, spins);
+    }
+}
+
+//! @brief consume records.size() records, spin if the ring is empty.
+template<typename T>
+void consume_all(zhb::shm_ring<T>& ring, std::span<T> records)
+{
+    for (int spins = 0; !records.empty();) {
+        const std::size_t n = ring.consume(records);
+        records = records.subspan(n);
+        backoff(n, spins);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* fwd = "/zhb_bench_shm_ring_fwd";
+    const char* bwd = "/zhb_bench_shm_ring_bwd";
+    zhb::shm_ring<Record>::unlink(fwd);
+    zhb::shm_ring<Record>::unlink(bwd);
+
+    constexpr std::size_t batch = 256;
+    const std::size_t n     = (argc > 1 ? std::atol(argv[1]) : 1 << 24) / batch * batch;
+    const std::size_t nping = argc > 2 ? std::atol(argv[2]) : 100000;
+
+    auto to_child   = zhb::shm_ring<Record>::create(fwd, 1 << 14);
+    auto from_child = zhb::shm_ring<Record>::create(bwd, 16);
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        std::vector<Record> buffer(batch);
+        for (std::size_t i = 0; i < n; i += batch)
+            consume_all<Record>(to_child, std::span<Record>(buffer));
+
+        // echo
+        Record r;
+        for (std::size_t i = 0; i < nping; ++i) {
+            consume_all<Record>(to_child, std::span<Record>(&r, 1));
+            publish_all<Record>(from_child, std::span<const Record>(&r, 1));
+        }
+        _exit(0);
+    }
+
+    std::vector<Record> buffer(batch);
+    auto t0 = clock_type::now();
+    for (std::size_t i = 0; i < n; i += batch)
+        publish_all<Record>(to_child, std::span<const Record>(buffer));
+    for (int spins = 0; to_child.size() > 0;)backoff(0, spins);
+    auto t1 = clock_type::now();
+    const double seconds = std::chrono::duration<double>(t1 - t0).count();
+    std::printf("stream   : %zu records of %zu bytes, batch %zu, %6.2f GB/s, %6.2f ns/record\n",
+        n, sizeof(Record), batch, n * sizeof(Record) / seconds / 1e9, seconds / n * 1e9);
+
+    Record r{};
+    t0 = clock_type::now();
+    for (std::size_t i = 0; i < nping; ++i) {
+        publish_all<Record>(to_child, std::span<const Record>(&r, 1));
+        consume_all<Record>(from_child, std::span<Record>(&r, 1));
+    }
+    t1 = clock_type::now();
+    std::printf("ping-pong: %7.1f ns one-way latency\n", std::chrono::duration<double, std::nano>(t1 - t0).count() / nping / 2);
+
+    waitpid(pid, nullptr, 0);
+    zhb::shm_ring<Record>::unlink(fwd);
+    zhb::shm_ring<Record>::unlink(bwd);
+
+    return 0;
+}
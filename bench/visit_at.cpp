@@ -0,0 +1,77 @@
+//!
+//! @brief   Benchmark of struct_traits<T>::visit_at against a hand-written if-chain.
+//!
+//! build:
+//!   g++ -std=c++20 -O2 -DNDEBUG -I.. visit_at.cpp -o visit_at
+//!
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "../struct_traits.hpp"
+
+// a record with 32 fields
+struct R
+{
+    int    i0, i1, i2, i3, i4, i5, i6, i7;
+    double d0, d1, d2, d3, d4, d5, d6, d7;
+    long   l0, l1, l2, l3, l4, l5, l6, l7;
+    float  f0, f1, f2, f3, f4, f5, f6, f7;
+};
+
+template<std::size_t... I>
+inline double get_by_if_chain(const R& r, std::size_t i, std::index_sequence<I...>)
+{
+    double val = 0;
+    // same as: if (i == 0) val = get<0>(r); else if (i == 1) val = get<1>(r); ...
+    (void)((i == I && (val = static_cast<double>(zhb::struct_traits<R>::get<I>(r)), true)) || ...);
+    return val;
+}
+
+template<typename Func>
+double run(const char* name, const std::vector<R>& records, const std::vector<std::size_t>& columns, Func&& get)
+{
+    constexpr int nrepeat = 2000;
+    double sum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < nrepeat; ++k)
+        for (std::size_t n = 0; n < records.size(); ++n)
+            sum += get(records[n], columns[n]);
+    auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (nrepeat * records.size());
+    std::printf("%-24s %8.3f ns/access (checksum %g)\n", name, ns, sum);
+    return ns;
+}
+
+int main()
+{
+    constexpr std::size_t n = 1 << 12; // fit in L1/L2 cache
+    constexpr std::size_t nf = zhb::num_fields_v<R>;
+
+    std::mt19937_64 rng(42);
+    std::vector<R> records(n);
+    std::vector<std::size_t> columns(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        zhb::struct_traits<R>::visit(records[i], [&rng](auto& val) { val = static_cast<std::remove_reference_t<decltype(val)>>(rng() % 100); });
+        columns[i] = rng() % nf;
+    }
+
+    auto if_chain = [](const R& r, std::size_t i) {
+        return get_by_if_chain(r, i, std::make_index_sequence<nf>{});
+        };
+    auto visit_at = [](const R& r, std::size_t i) {
+        return zhb::struct_traits<R>::visit_at(r, i, [](auto& val) { return static_cast<double>(val); });
+        };
+
+    // random column per record
+    run("if-chain (random)", records, columns, if_chain);
+    run("visit_at (random)", records, columns, visit_at);
+
+    // the last column only, the worst case of the if-chain
+    std::vector<std::size_t> last(n, nf - 1);
+    run("if-chain (last field)", records, last, if_chain);
+    run("visit_at (last field)", records, last, visit_at);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+//!
+//! @brief   Benchmark of zhb::visit_columns: per-field transform of a span of records, per record by struct_traits::visit
+//!          against per column, and the scaling of the parallel overload from 1 to N threads.
+//!
+//! build:
+//!   g++ -std=c++20 -O2 -DNDEBUG -I.. visit_columns.cpp -o visit_columns -pthread
+//!
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib> // atoi
+#include <thread>
+#include <vector>
+#include "../visit_columns.hpp"
+
+struct Record
+{
+    double x, y, z;
+    float  mass;
+    int    id;
+    double vx, vy, vz;
+};
+
+// unit conversion of floating point fields, clamp of integers
+struct transform
+{
+    template<typename U>
+    void operator()(U& v)const noexcept
+    {
+        if constexpr (std::is_floating_point_v<U>)v *= U(0.3048);
+        else v = std::clamp(v, U(0), U(1 << 20));
+    }
+
+    template<typename U, std::size_t Stride>
+    void operator()(zhb::strided_span<U, Stride> column)const noexcept
+    {
+        for (auto& v : column)(*this)(v);
+    }
+};
+
+template<typename Func>
+double run(Func&& func)
+{
+    constexpr int nrepeat = 10;
+    func(); // warm up
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < nrepeat; ++k)func();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count() / nrepeat;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t n = argc > 1 ? std::atol(argv[1]) : 10'000'000;
+    const std::size_t max_threads = argc > 2 ? std::atol(argv[2]) : std::thread::hardware_concurrency();
+
+    std::vector<Record> records(n);
+    for (std::size_t i = 0; i < n; ++i)
+        zhb::struct_traits<Record>::visit(records[i], [i](auto& val) { val = static_cast<std::remove_reference_t<decltype(val)>>(i % 1000); });
+
+    const double gbytes = double(n) * sizeof(Record) / 1e9;
+    std::printf("%zu records of %zu bytes\n", n, sizeof(Record));
+
+    const double t_record = run([&] {
+        for (auto& r : records)zhb::struct_traits<Record>::visit(r, transform{});
+        });
+    std::printf("  per record (struct_traits::visit) %7.2f ms  %6.2f GB/s\n", t_record * 1e3, gbytes / t_record);
+
+    const double t_column = run([&] { zhb::visit_columns<Record>(records, transform{}); });
+    std::printf("  per column (visit_columns)        %7.2f ms  %6.2f GB/s\n", t_column * 1e3, gbytes / t_column);
+
+    double t1 = 0;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        const double t = run([&] { zhb::visit_columns<Record>(records, transform{}, threads); });
+        if (threads == 1)t1 = t;
+        std::printf("  %2zu threads, blocked               %7.2f ms  %6.2f GB/s  speedup %5.2f\n",
+            threads, t * 1e3, gbytes / t, t1 / t);
+    }
+
+    return 0;
+}
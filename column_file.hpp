@@ -0,0 +1,356 @@
+//!
+//! @brief   Memory-mapped columnar file of aggregate records, the schema is derived from struct_traits.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! Every field is stored in its own contiguous column, every column starts at a multiple of column_alignment (64 KiB),
+//! which is a multiple of the page size of common systems (4 KiB, 16 KiB or 64 KiB), so that the format does not depend
+//! on the host writing the file:
+//!
+//!   | header | field table | pad | column 0 | pad | column 1 | pad | ... | column N-1 |
+//!
+//! The header and field table record layout_fingerprint_v<T>, num_fields_v<T>, sizeof(T) and the offset, size,
+//! number of elements and file offset of every field, they are checked against T when the file is opened.
+//! The reader maps the file and returns the columns as spans without copying, so only the pages
+//! of the columns being read are touched.
+//!
+//! POSIX only (open/mmap).
+//!
+
+#pragma once
+#include <algorithm> // min
+#include <cerrno>
+#include <cstdint>  // uint64_t
+#include <cstring>  // memcpy, memcmp, memmove
+#include <limits>
+#include <span>
+#include <stdexcept> // length_error
+#include <system_error>
+#include <utility>  // exchange, swap
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close, ftruncate
+
+#include "aos_soa.hpp"
+#include "hash.hpp"
+
+namespace zhb {
+
+    namespace detail
+    {
+        //! @brief header at the beginning of the column file.
+        struct column_file_header_
+        {
+            char          magic[8];
+            std::uint32_t version;
+            std::uint32_t num_fields;
+            std::uint64_t num_records;
+            std::uint64_t record_size;
+            std::uint64_t fingerprint; //!< layout_fingerprint_v<T>
+        };
+
+        //! @brief description of one field in the column file, follows the header.
+        struct column_file_field_
+        {
+            std::uint64_t offset;        //!< offset of the field in the record.
+            std::uint64_t size;          //!< size of the field in bytes.
+            std::uint64_t count;         //!< number of elements, > 1 if the field is array.
+            std::uint64_t column_offset; //!< offset of the column in the file.
+        };
+
+        inline constexpr char          column_file_magic_[8] = { 'Z', 'H', 'B', 'C', 'O', 'L', 'F', '\0' };
+        inline constexpr std::uint32_t column_file_version_  = 3;
+
+        //! @brief alignment of the columns in the file, part of the format.
+        inline constexpr std::size_t column_file_alignment_ = 64 * 1024;
+
+        //! @brief layout of the column file of \T having \n records.
+        template<aggregate T>
+        struct column_file_layout_
+        {
+            inline static constexpr std::size_t alignment = column_file_alignment_;
+            inline static constexpr std::size_t num_fields = num_fields_v<T>;
+
+            //! @brief largest file size, aligned and representable by off_t.
+            inline static constexpr std::size_t max_file_size =
+                std::min<std::size_t>(std::numeric_limits<off_t>::max(), std::numeric_limits<std::size_t>::max()) / alignment * alignment;
+
+            static constexpr std::size_t align_up_(std::size_t x)noexcept { return (x + alignment - 1) / alignment * alignment; }
+
+            //! @brief fill the header and the field table.
+            //! @return false if the file of \n records would be larger than max_file_size.
+            [[nodiscard]] static bool describe(std::size_t n, column_file_header_& header, column_file_field_ (&fields)[num_fields])noexcept
+            {
+                std::memcpy(header.magic, column_file_magic_, sizeof(header.magic));
+                header.version     = column_file_version_;
+                header.num_fields  = static_cast<std::uint32_t>(num_fields);
+                header.num_records = n;
+                header.record_size = sizeof(T);
+                header.fingerprint = layout_fingerprint_v<T>;
+
+                std::size_t pos = align_up_(sizeof(column_file_header_) + sizeof(fields));
+                [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    ((fields[I] = { offsets_v<T>[I], sizes_v<T>[I], sizes_v<T>[I] / sizeof(std::remove_all_extents_t<field_type_t<T, I>>), 0 }), ...);
+                }(std::make_index_sequence<num_fields>{});
+                for (auto& f : fields) {
+                    f.column_offset = pos;
+                    if (n > (max_file_size - pos) / f.size)return false; // pos + f.size * n overflows
+                    pos = align_up_(pos + f.size * n);
+                }
+                return true;
+            }
+
+            //! @brief total size of the file.
+            static std::size_t file_size(const column_file_field_ (&fields)[num_fields], std::size_t n)noexcept
+            {
+                if constexpr (num_fields == 0)
+                    return align_up_(sizeof(column_file_header_));
+                else
+                    return fields[num_fields - 1].column_offset + fields[num_fields - 1].size * n;
+            }
+        };
+
+        [[noreturn]] inline void throw_errno_(const char* what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+    }
+
+    template<aggregate T>
+    struct column_file
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "column_file only supports trivially copyable struct!");
+
+        inline static constexpr std::size_t num_fields = num_fields_v<T>;
+
+        //! @brief type of the I-th column.
+        template<std::size_t I>
+        using column_type = field_type_t<T, I>;
+
+        //! @brief Write a column file of known number of records, records are appended chunk by chunk.
+        class writer
+        {
+        public:
+            //! @brief Create the file for \num_records records.
+            //! @throw std::system_error if the file can NOT be created.
+            writer(const char* path, std::size_t num_records)
+                : capacity_(num_records)
+            {
+                using layout = detail::column_file_layout_<T>;
+                detail::column_file_header_ header;
+                if (!layout::describe(num_records, header, fields_))
+                    throw std::system_error(std::make_error_code(std::errc::file_too_large), "column_file::writer: too many records");
+                size_ = layout::file_size(fields_, num_records);
+
+                fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+                if (fd_ < 0)detail::throw_errno_("column_file::writer: open");
+                if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0)fail_("column_file::writer: ftruncate");
+
+                void* p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+                if (p == MAP_FAILED)fail_("column_file::writer: mmap");
+                data_ = static_cast<std::byte*>(p);
+
+                std::memcpy(data_, &header, sizeof(header));
+                std::memcpy(data_ + sizeof(header), fields_, sizeof(fields_));
+            }
+
+            writer(const writer&) = delete;
+            writer& operator = (const writer&) = delete;
+
+            ~writer() { close(); }
+
+            //! @brief Append records, the columns are filled by aos_to_soa.
+            //! @throw std::length_error if more than num_records records would be appended, nothing is appended.
+            void append(std::span<const T> records)
+            {
+                if (records.size() > capacity_ - count_)throw std::length_error("column_file::writer::append: too many records");
+                column_pointers<T> columns;
+                for (std::size_t i = 0; i < num_fields; ++i)
+                    columns[i] = data_ + fields_[i].column_offset + fields_[i].size * count_;
+                aos_to_soa<T>(records.data(), records.size(), columns);
+                count_ += records.size();
+            }
+
+            //! @brief number of appended records.
+            std::size_t size()const noexcept { return count_; }
+
+            //! @brief Flush and close the file.
+            //! @note  if less than num_records records are appended, e.g. the writer is destroyed by an exception,
+            //!        the columns are moved and the file is truncated so that it holds the size() appended records.
+            void close()noexcept
+            {
+                if (data_ != nullptr) {
+                    if (count_ < capacity_)shrink_();
+                    ::munmap(std::exchange(data_, nullptr), size_);
+                }
+                if (fd_ >= 0) {
+                    if (count_ < capacity_)static_cast<void>(::ftruncate(fd_, static_cast<off_t>(detail::column_file_layout_<T>::file_size(fields_, count_))));
+                    ::close(std::exchange(fd_, -1));
+                }
+            }
+
+        private:
+            //! @brief move the columns to the layout of count_ records, every column moves to a lower offset.
+            void shrink_()noexcept
+            {
+                detail::column_file_header_ header;
+                detail::column_file_field_  fields[num_fields == 0 ? 1 : num_fields];
+                static_cast<void>(detail::column_file_layout_<T>::describe(count_, header, fields)); // count_ < capacity_, no overflow
+                for (std::size_t i = 0; i < num_fields; ++i)
+                    std::memmove(data_ + fields[i].column_offset, data_ + fields_[i].column_offset, fields[i].size * count_);
+
+                std::memcpy(data_, &header, sizeof(header));
+                std::memcpy(data_ + sizeof(header), fields, sizeof(fields_));
+                std::memcpy(fields_, fields, sizeof(fields_));
+            }
+
+            [[noreturn]] void fail_(const char* what)
+            {
+                const int err = errno;
+                close_fd_();
+                throw std::system_error(err, std::generic_category(), what);
+            }
+
+            void close_fd_()noexcept { if (fd_ >= 0)::close(std::exchange(fd_, -1)); }
+
+            int         fd_       = -1;
+            std::byte*  data_     = nullptr;
+            std::size_t size_     = 0;
+            std::size_t capacity_ = 0;
+            std::size_t count_    = 0;
+
+            detail::column_file_field_ fields_[num_fields == 0 ? 1 : num_fields]{};
+        };
+
+        //! @brief Map a column file read-only.
+        class reader
+        {
+        public:
+            reader() = default;
+
+            //! @brief Open and map the file, the layout recorded in the file is checked against \T.
+            //! @throw std::system_error if the file can NOT be mapped or the layout is different.
+            explicit reader(const char* path)
+            {
+                const int fd = ::open(path, O_RDONLY);
+                if (fd < 0)detail::throw_errno_("column_file::reader: open");
+
+                struct stat st;
+                if (::fstat(fd, &st) != 0) {
+                    const int err = errno;
+                    ::close(fd);
+                    throw std::system_error(err, std::generic_category(), "column_file::reader: fstat");
+                }
+                size_ = static_cast<std::size_t>(st.st_size);
+
+                void* p = size_ > 0 ? ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+                const int err = errno;
+                ::close(fd); // the mapping is kept after closing
+                if (p == MAP_FAILED)throw std::system_error(size_ > 0 ? err : EINVAL, std::generic_category(), "column_file::reader: mmap");
+                data_ = static_cast<const std::byte*>(p);
+
+                if (!check_()) {
+                    unmap_();
+                    throw std::system_error(std::make_error_code(std::errc::invalid_argument), "column_file::reader: layout mismatch");
+                }
+            }
+
+            reader(reader&& other)noexcept { swap(other); }
+
+            reader& operator = (reader&& other)noexcept
+            {
+                reader(std::move(other)).swap(*this);
+                return *this;
+            }
+
+            ~reader() { unmap_(); }
+
+            void swap(reader& other)noexcept
+            {
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                std::swap(count_, other.count_);
+            }
+
+            //! @brief number of records.
+            std::size_t size()const noexcept { return count_; }
+
+            //! @brief The I-th column, mapped from the file without copying.
+            template<std::size_t I>
+            std::span<const column_type<I>> column()const noexcept
+            {
+                if (data_ == nullptr)return {}; // default constructed
+                return { reinterpret_cast<const column_type<I>*>(data_ + fields_()[I].column_offset), count_ };
+            }
+
+            //! @brief Copy the records [first, first + records.size()) from the columns.
+            void read(std::size_t first, std::span<T> records)const noexcept
+            {
+                assert(first + records.size() <= count_);
+                if (records.empty())return;
+                const_column_pointers<T> columns;
+                for (std::size_t i = 0; i < num_fields; ++i)
+                    columns[i] = data_ + fields_()[i].column_offset + fields_()[i].size * first;
+                soa_to_aos<T>(columns, records.size(), records.data());
+            }
+
+            //! @brief Copy the i-th record from the columns.
+            T operator [] (std::size_t i)const noexcept
+            {
+                T value;
+                read(i, std::span<T>(&value, 1));
+                return value;
+            }
+
+        private:
+            const detail::column_file_field_* fields_()const noexcept
+            {
+                return reinterpret_cast<const detail::column_file_field_*>(data_ + sizeof(detail::column_file_header_));
+            }
+
+            //! @brief check the header and field table against \T.
+            bool check_()noexcept
+            {
+                using layout = detail::column_file_layout_<T>;
+                detail::column_file_header_ header;
+                if (size_ < sizeof(header) + num_fields * sizeof(detail::column_file_field_))return false;
+                std::memcpy(&header, data_, sizeof(header));
+
+                if (std::memcmp(header.magic, detail::column_file_magic_, sizeof(header.magic)) != 0 ||
+                    header.version != detail::column_file_version_ ||
+                    header.fingerprint != layout_fingerprint_v<T> ||
+                    header.num_fields != num_fields || header.record_size != sizeof(T))return false;
+
+                detail::column_file_header_ expected_header;
+                detail::column_file_field_  expected[num_fields == 0 ? 1 : num_fields];
+                if constexpr (num_fields > 0) {
+                    if (!layout::describe(header.num_records, expected_header, expected))return false;
+                    if (std::memcmp(expected, fields_(), sizeof(expected)) != 0)return false;
+                    if (size_ < layout::file_size(expected, header.num_records))return false;
+                }
+                count_ = header.num_records;
+                return true;
+            }
+
+            void unmap_()noexcept
+            {
+                if (data_ != nullptr)::munmap(const_cast<std::byte*>(std::exchange(data_, nullptr)), size_);
+            }
+
+            const std::byte* data_  = nullptr;
+            std::size_t      size_  = 0;
+            std::size_t      count_ = 0;
+        };
+
+        //! @brief Write all records into a new column file.
+        //! @throw std::system_error if the file can NOT be created.
+        static void write(const char* path, std::span<const T> records)
+        {
+            writer w(path, records.size());
+            w.append(records);
+        }
+    };
+}
@@ -0,0 +1,173 @@
+//!
+//! @brief   Reflective equality and ordering of aggregate types.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! The fields are compared in declaration order and nested aggregates and arrays are recursed into:
+//!   1) struct having unique object representation (no padding, no floating point) is compared by one memcmp,
+//!   2) otherwise adjacent fields having unique object representation are compared by one memcmp,
+//!      floating point fields are compared by value with IEEE semantics (NaN != NaN, +0.0 == -0.0),
+//!      other fields are compared by operator== and operator<=>.
+//!
+
+#pragma once
+#include <algorithm> // upper_bound
+#include <compare>
+#include <cstdint>   // uint64_t
+#include <cstring>   // memcmp
+#include <span>
+#include <vector>
+
+#include "field_segments.hpp"
+
+namespace zhb {
+
+    namespace detail
+    {
+        //! @brief comparison category of the value.
+        template<typename U>
+        struct compare_category_ { using type = std::compare_three_way_result_t<U>; };
+
+        template<typename U, std::size_t N>
+        struct compare_category_<U[N]> : compare_category_<U> {};
+
+        template<aggregate U, std::size_t... I>
+        auto compare_category_fields_(std::index_sequence<I...>)
+            -> std::common_comparison_category_t<typename compare_category_<field_type_t<U, I>>::type...>;
+
+        template<aggregate U>
+        struct compare_category_<U> { using type = decltype(compare_category_fields_<U>(std::make_index_sequence<num_fields_v<U>>{})); };
+
+        template<typename U> bool equal_value_(const U& a, const U& b)noexcept;
+        template<typename U> typename compare_category_<U>::type compare_value_(const U& a, const U& b)noexcept;
+
+        template<aggregate U, std::size_t... I>
+        inline bool equal_fields_(const U& a, const U& b, std::index_sequence<I...>)noexcept
+        {
+            constexpr auto& seg = field_segments_<U>::segments;
+            return ((seg[I].size > 0
+                ? std::memcmp(&struct_traits<U>::template get<seg[I].field>(a), &struct_traits<U>::template get<seg[I].field>(b), seg[I].size) == 0
+                : equal_value_(struct_traits<U>::template get<seg[I].field>(a), struct_traits<U>::template get<seg[I].field>(b))) && ...);
+        }
+
+        //! @brief whether or not two values are equal.
+        template<typename U>
+        inline bool equal_value_(const U& a, const U& b)noexcept
+        {
+            if constexpr (has_unique_representation_<U>) {
+                return std::memcmp(&a, &b, sizeof(U)) == 0;
+            }
+            else if constexpr (std::is_array_v<U>) {
+                for (std::size_t i = 0; i < std::extent_v<U>; ++i)
+                    if (!equal_value_(a[i], b[i]))return false;
+                return true;
+            }
+            else if constexpr (aggregate<U>) {
+                return equal_fields_(a, b, std::make_index_sequence<field_segments_<U>::segments.size()>{});
+            }
+            else {
+                return a == b;
+            }
+        }
+
+        template<aggregate U, std::size_t... I>
+        inline auto compare_fields_(const U& a, const U& b, std::index_sequence<I...>)noexcept
+        {
+            using result_type = typename compare_category_<U>::type;
+            result_type r = std::strong_ordering::equal;
+            (((r = compare_value_(struct_traits<U>::template get<I>(a), struct_traits<U>::template get<I>(b))) == 0) && ...);
+            return r;
+        }
+
+        //! @brief get offset of the first different byte, or sizeof(U) if all bytes are the same.
+        template<typename U>
+        inline std::size_t first_different_byte_(const U& a, const U& b)noexcept
+        {
+            const auto pa = reinterpret_cast<const unsigned char*>(&a);
+            const auto pb = reinterpret_cast<const unsigned char*>(&b);
+            std::size_t i = 0;
+            for (; i + 8 <= sizeof(U); i += 8) {
+                std::uint64_t wa, wb;
+                std::memcpy(&wa, pa + i, 8);
+                std::memcpy(&wb, pb + i, 8);
+                if (wa != wb)break;
+            }
+            for (; i < sizeof(U) && pa[i] == pb[i]; ++i) {}
+            return i;
+        }
+
+        //! @brief three-way comparison of two values, fields are compared in declaration order.
+        template<typename U>
+        inline typename compare_category_<U>::type compare_value_(const U& a, const U& b)noexcept
+        {
+            using result_type = typename compare_category_<U>::type;
+
+            if constexpr (std::is_array_v<U>) {
+                for (std::size_t i = 0; i < std::extent_v<U>; ++i)
+                    if (auto r = compare_value_(a[i], b[i]); r != 0)return r;
+                return std::strong_ordering::equal;
+            }
+            else if constexpr (aggregate<U> && has_unique_representation_<U>) {
+                // skip the fields before the first different byte, which are equal
+                const std::size_t pos = first_different_byte_(a, b);
+                if (pos == sizeof(U))return std::strong_ordering::equal;
+
+                const std::size_t field = std::upper_bound(offsets_v<U>.begin(), offsets_v<U>.end(), pos) - offsets_v<U>.begin() - 1;
+                return struct_traits<U>::visit_at(a, field, [&a, &b](auto& fa) -> result_type {
+                    using field_type = std::remove_cvref_t<decltype(fa)>;
+                    const auto off = reinterpret_cast<const std::byte*>(&fa) - reinterpret_cast<const std::byte*>(&a);
+                    return compare_value_(fa, *reinterpret_cast<const field_type*>(reinterpret_cast<const std::byte*>(&b) + off));
+                    });
+            }
+            else if constexpr (aggregate<U>) {
+                return compare_fields_(a, b, std::make_index_sequence<num_fields_v<U>>{});
+            }
+            else {
+                return a <=> b;
+            }
+        }
+    }
+
+    //! @brief comparison category of \T, std::partial_ordering if any floating point field.
+    template<aggregate T> using compare_result_t = typename detail::compare_category_<T>::type;
+
+    //! @brief Whether or not all fields of \a and \b are equal.
+    template<aggregate T>
+    inline bool equal(const T& a, const T& b)noexcept
+    {
+        return detail::equal_value_(a, b);
+    }
+
+    //! @brief Compare fields of \a and \b in declaration order (lexicographical).
+    template<aggregate T>
+    inline compare_result_t<T> compare(const T& a, const T& b)noexcept
+    {
+        return detail::compare_value_(a, b);
+    }
+
+    //! @brief Find the changed records, bit i%64 of bitmap[i/64] is set if !equal(old[i], now[i]).
+    //! @note  \bitmap should have (old.size() + 63) / 64 words, \old and \now should have the same size.
+    template<aggregate T>
+    inline void find_changed(std::span<const T> old, std::span<const T> now, std::uint64_t* bitmap)noexcept
+    {
+        assert(old.size() == now.size());
+        const std::size_t n = old.size();
+        for (std::size_t w = 0; w * 64 < n; ++w) {
+            const std::size_t begin = w * 64, end = n - begin < 64 ? n : begin + 64;
+            std::uint64_t bits = 0;
+            for (std::size_t i = begin; i < end; ++i)
+                bits |= std::uint64_t(!equal(old[i], now[i])) << (i - begin);
+            bitmap[w] = bits;
+        }
+    }
+
+    //! @brief Find the changed records, bit i%64 of the i/64-th word is set if !equal(old[i], now[i]).
+    template<aggregate T>
+    inline std::vector<std::uint64_t> find_changed(std::span<const T> old, std::span<const T> now)
+    {
+        std::vector<std::uint64_t> bitmap((old.size() + 63) / 64);
+        find_changed(old, now, bitmap.data());
+        return bitmap;
+    }
+}
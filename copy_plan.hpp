@@ -0,0 +1,148 @@
+//!
+//! @brief   Copy plan: pack/unpack a struct to/from a dense layout without padding bytes.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! The plan is computed at compiling time from the offsets and sizes of the leaf fields (flatten_traits),
+//! adjacent leaves are merged into one memcpy block, e.g. for
+//!
+//!   struct B { int b0; char b1; };
+//!   struct A { int a0[3]; double a1; char a2; B a3[2]; int a4; C a5; float a6[2][3]; };
+//!
+//! the plan is 5 blocks: {a0}, {a1,a2}, {a3[0]}, {a3[1]}, {a4,a5,a6},
+//! the padding inside nested struct fields is skipped too.
+//!
+
+#pragma once
+#include <cstddef>  // byte
+#include <cstring>  // memcpy
+#include <span>
+
+#include "flatten_traits.hpp"
+
+namespace zhb {
+
+    //! @brief a contiguous memory block copied by one memcpy.
+    struct copy_block
+    {
+        std::size_t src_offset; //!< offset in the struct.
+        std::size_t dst_offset; //!< offset in the packed data.
+        std::size_t size;       //!< bytes of the block.
+    };
+
+    namespace detail
+    {
+        //! @brief whether or not the k-th leaf starts a new block, i.e. it does not follow the previous leaf.
+        template<aggregate T>
+        inline consteval bool new_copy_block_(std::size_t k)noexcept
+        {
+            constexpr auto& leaves = flatten_traits<T>::leaves;
+            return k == 0 || leaves[k - 1].offset + leaves[k - 1].size * leaves[k - 1].count != leaves[k].offset;
+        }
+
+        //! @brief number of blocks after merging adjacent leaves.
+        template<aggregate T>
+        inline consteval std::size_t num_copy_blocks_()noexcept
+        {
+            std::size_t n = 0;
+            for (std::size_t k = 0; k < flatten_traits<T>::num_leaves; ++k)
+                if (new_copy_block_<T>(k))++n;
+            return n;
+        }
+
+        template<aggregate T>
+        inline consteval std::array<copy_block, num_copy_blocks_<T>()> copy_blocks_()noexcept
+        {
+            std::array<copy_block, num_copy_blocks_<T>()> blocks{};
+            std::size_t n = 0, dst = 0;
+            for (std::size_t k = 0; k < flatten_traits<T>::num_leaves; ++k) {
+                const leaf_info& leaf = flatten_traits<T>::leaves[k];
+                if (new_copy_block_<T>(k))
+                    blocks[n++] = { leaf.offset, dst, 0 };
+                blocks[n - 1].size += leaf.size * leaf.count;
+                dst += leaf.size * leaf.count;
+            }
+            return blocks;
+        }
+
+        template<aggregate T>
+        inline consteval std::size_t packed_size_()noexcept
+        {
+            std::size_t n = 0;
+            for (const leaf_info& leaf : flatten_traits<T>::leaves)n += leaf.size * leaf.count;
+            return n;
+        }
+    }
+
+    //! @brief Get the memcpy blocks used to pack/unpack \T.
+    template<aggregate T> constexpr std::array<copy_block, detail::num_copy_blocks_<T>()> copy_plan_v = detail::copy_blocks_<T>();
+
+    //! @brief Get the size in bytes of packed \T, i.e. sum of the leaf field sizes.
+    template<aggregate T> constexpr std::size_t packed_size_v = detail::packed_size_<T>();
+
+    namespace detail
+    {
+        template<aggregate T, std::size_t... I>
+        inline void pack_(const std::byte* src, std::byte* dst, std::index_sequence<I...>)noexcept
+        {
+            (std::memcpy(dst + copy_plan_v<T>[I].dst_offset, src + copy_plan_v<T>[I].src_offset, copy_plan_v<T>[I].size), ...);
+        }
+
+        template<aggregate T, std::size_t... I>
+        inline void unpack_(const std::byte* src, std::byte* dst, std::index_sequence<I...>)noexcept
+        {
+            (std::memcpy(dst + copy_plan_v<T>[I].src_offset, src + copy_plan_v<T>[I].dst_offset, copy_plan_v<T>[I].size), ...);
+        }
+    }
+
+    //! @brief Copy all fields of \data to \out without padding bytes.
+    //! @return the end of the packed data, i.e. out + packed_size_v<T>.
+    template<aggregate T>
+    inline std::byte* pack(const T& data, std::byte* out)noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable struct is supported!");
+        detail::pack_<T>(reinterpret_cast<const std::byte*>(&data), out, std::make_index_sequence<copy_plan_v<T>.size()>{});
+        return out + packed_size_v<T>;
+    }
+
+    //! @brief Copy all fields of \data from the packed data \in.
+    //! @return the end of the packed data, i.e. in + packed_size_v<T>.
+    template<aggregate T>
+    inline const std::byte* unpack(const std::byte* in, T& data)noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable struct is supported!");
+        detail::unpack_<T>(in, reinterpret_cast<std::byte*>(&data), std::make_index_sequence<copy_plan_v<T>.size()>{});
+        return in + packed_size_v<T>;
+    }
+
+    //! @brief Pack all the records one after another.
+    //! @return the end of the packed data, i.e. out + packed_size_v<T> * data.size().
+    template<aggregate T>
+    inline std::byte* pack(std::span<const T> data, std::byte* out)noexcept
+    {
+        if constexpr (packed_size_v<T> == sizeof(T)) {
+            if (!data.empty())std::memcpy(out, data.data(), data.size_bytes());
+            return out + data.size_bytes();
+        }
+        else {
+            for (const T& d : data)out = pack(d, out);
+            return out;
+        }
+    }
+
+    //! @brief Unpack all the records one after another.
+    //! @return the end of the packed data, i.e. in + packed_size_v<T> * data.size().
+    template<aggregate T>
+    inline const std::byte* unpack(const std::byte* in, std::span<T> data)noexcept
+    {
+        if constexpr (packed_size_v<T> == sizeof(T)) {
+            if (!data.empty())std::memcpy(data.data(), in, data.size_bytes());
+            return in + data.size_bytes();
+        }
+        else {
+            for (T& d : data)in = unpack(in, d);
+            return in;
+        }
+    }
+}
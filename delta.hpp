@@ -0,0 +1,143 @@
+//!
+//! @brief   Field-level delta encoding between two instances of an aggregate.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! Every leaf field (flatten_traits) is a unit of the patch, nested structs are expanded and array fields are split
+//! to their elements, e.g. float[2][3] is 6 units, so that the padding bytes are never compared nor sent.
+//! The patch is:
+//!
+//!   | changed bitmask, (num_units + 7) / 8 bytes | bytes of the changed units, in field order |
+//!
+//! bit u%8 of byte u/8 is set if unit u is changed. Units are compared by bytes (memcmp),
+//! so that -0.0 -> +0.0 is sent and NaN is not resent.
+//!
+
+#pragma once
+#include <cstddef>  // byte
+#include <cstdint>  // uint8_t
+#include <cstring>  // memcpy, memcmp
+#include <vector>
+
+#include "flatten_traits.hpp"
+
+namespace zhb {
+
+    //! @brief a simple writer appending bytes to std::vector, see diff().
+    struct vector_writer
+    {
+        std::vector<std::byte>& bytes;
+
+        void write(const std::byte* data, std::size_t size)
+        {
+            bytes.insert(bytes.end(), data, data + size);
+        }
+    };
+
+    namespace detail
+    {
+        //! @brief units of the patch, one per element of every leaf field.
+        template<aggregate T>
+        struct delta_layout_
+        {
+            inline static constexpr std::size_t num_leaves = flatten_traits<T>::num_leaves;
+            inline static constexpr const auto& leaves     = flatten_traits<T>::leaves;
+
+            inline static constexpr std::size_t num_units = [] {
+                std::size_t n = 0;
+                for (const leaf_info& leaf : leaves)n += leaf.count;
+                return n;
+            }();
+
+            inline static constexpr std::size_t mask_bytes = (num_units + 7) / 8;
+
+            //! @brief bytes of all units.
+            inline static constexpr std::size_t data_bytes = [] {
+                std::size_t n = 0;
+                for (const leaf_info& leaf : leaves)n += leaf.size * leaf.count;
+                return n;
+            }();
+        };
+    }
+
+    //! @brief maximum size in bytes of the patch of \T, i.e. all fields are changed.
+    template<aggregate T> constexpr std::size_t max_patch_size_v = detail::delta_layout_<T>::mask_bytes + detail::delta_layout_<T>::data_bytes;
+
+    //! @brief Write the patch from \old to \now.
+    //! @param writer  should have a member function write(const std::byte* data, std::size_t size).
+    //! @return size in bytes of the patch.
+    template<aggregate T, typename Writer>
+    inline std::size_t diff(const T& old, const T& now, Writer& writer)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable struct is supported!");
+        using layout = detail::delta_layout_<T>;
+
+        const auto po = reinterpret_cast<const std::byte*>(&old);
+        const auto pn = reinterpret_cast<const std::byte*>(&now);
+
+        // find the changed units
+        std::array<std::uint8_t, layout::mask_bytes> mask{};
+        std::size_t u = 0, nbytes = 0;
+        for (const leaf_info& leaf : layout::leaves) {
+            const std::size_t off = leaf.offset, size = leaf.size, count = leaf.count;
+            if (count > 1 && std::memcmp(po + off, pn + off, size * count) == 0) {
+                u += count; // the whole array is unchanged
+                continue;
+            }
+            for (std::size_t j = 0; j < count; ++j, ++u) {
+                if (std::memcmp(po + off + j * size, pn + off + j * size, size) != 0) {
+                    mask[u / 8] |= std::uint8_t(1u << (u % 8));
+                    nbytes += size;
+                }
+            }
+        }
+        writer.write(reinterpret_cast<const std::byte*>(mask.data()), mask.size());
+
+        // write the changed units, adjacent units are written at once
+        std::size_t run_begin = 0, run_size = 0;
+        u = 0;
+        for (const leaf_info& leaf : layout::leaves) {
+            const std::size_t size = leaf.size;
+            for (std::size_t j = 0; j < leaf.count; ++j, ++u) {
+                if (!(mask[u / 8] & (1u << (u % 8))))continue;
+                const std::size_t off = leaf.offset + j * size;
+                if (run_size > 0 && run_begin + run_size == off) {
+                    run_size += size;
+                }
+                else {
+                    if (run_size > 0)writer.write(pn + run_begin, run_size);
+                    run_begin = off;
+                    run_size  = size;
+                }
+            }
+        }
+        if (run_size > 0)writer.write(pn + run_begin, run_size);
+
+        return mask.size() + nbytes;
+    }
+
+    //! @brief Apply the patch written by diff().
+    //! @return the end of the patch.
+    template<aggregate T>
+    inline const std::byte* apply_patch(T& data, const std::byte* patch)noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable struct is supported!");
+        using layout = detail::delta_layout_<T>;
+
+        const auto mask = reinterpret_cast<const std::uint8_t*>(patch);
+        const std::byte* p = patch + layout::mask_bytes;
+        const auto pd = reinterpret_cast<std::byte*>(&data);
+
+        std::size_t u = 0;
+        for (const leaf_info& leaf : layout::leaves) {
+            const std::size_t off = leaf.offset, size = leaf.size;
+            for (std::size_t j = 0; j < leaf.count; ++j, ++u) {
+                if (!(mask[u / 8] & (1u << (u % 8))))continue;
+                std::memcpy(pd + off + j * size, p, size);
+                p += size;
+            }
+        }
+        return p;
+    }
+}
@@ -0,0 +1,108 @@
+#include <cstdio> // printf
+#include <cstdlib> // atoi
+#include <vector>
+#include "MPITypes.hpp"
+
+//
+// Bandwidth of the datatypes created by mpi::Data<T>:
+//   struct : one block per field, i.e. MPI_Type_create_struct without optimization,
+//   type   : contiguous / merged blocks,
+//   byte   : contiguous MPI_BYTE, valid for homogeneous ranks only.
+//
+// Ranks are paired (0<->1, 2<->3, ...) and exchange arrays of records by ping-pong.
+//
+// mpicxx -std=c++20 -O2 -I.. BenchMPITypes.cpp -o BenchMPITypes
+// mpirun -np 4 ./BenchMPITypes [num_records] [repeats]
+//
+
+// no padding and ONE type: contiguous of MPI_DOUBLE
+struct Particle {
+    double x, y, z;
+    double vx, vy, vz;
+};
+
+// no padding: 8 fields are merged into 3 blocks
+struct Record {
+    double x, y, z;
+    double vx, vy, vz;
+    float  mass;
+    int    id;
+};
+
+// padded
+struct Padded {
+    double a0;
+    int    a1[2];
+    char   a2;
+};
+
+template<typename T>
+double pingpong(std::vector<T>& data, MPI_Datatype type, int repeats, int rank)
+{
+    const int peer = rank ^ 1;
+    const int n = static_cast<int>(data.size());
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double t0 = MPI_Wtime();
+    for (int r = 0; r < repeats; ++r) {
+        if (rank % 2 == 0) {
+            MPI_Send(data.data(), n, type, peer, 0, MPI_COMM_WORLD);
+            MPI_Recv(data.data(), n, type, peer, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+        else {
+            MPI_Recv(data.data(), n, type, peer, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            MPI_Send(data.data(), n, type, peer, 0, MPI_COMM_WORLD);
+        }
+    }
+    const double t = MPI_Wtime() - t0;
+
+    double tmax = 0;
+    MPI_Reduce(&t, &tmax, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    // bytes of records sent in both directions per pair
+    return 2.0 * repeats * n * sizeof(T) / tmax / 1e9;
+}
+
+template<typename T>
+void bench(const char* name, int n, int repeats, int rank)
+{
+    std::vector<T> data(n);
+
+    pingpong(data, mpi::Data<T>::type(), 1, rank); // warm up
+
+    const double bw_struct = pingpong(data, mpi::Data<T>::struct_type(), repeats, rank);
+    const double bw_type   = pingpong(data, mpi::Data<T>::type(), repeats, rank);
+    const double bw_byte   = pingpong(data, mpi::Data<T>::byte_type(), repeats, rank);
+
+    if (rank == 0)
+        printf("%-10s %4zu bytes  struct %6.2f GB/s  type %6.2f GB/s  byte %6.2f GB/s\n",
+            name, sizeof(T), bw_struct, bw_type, bw_byte);
+}
+
+int main(int argc, char** argv)
+{
+    int rank = 0, size = 0;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    if (size % 2 != 0) {
+        if (rank == 0)printf("number of ranks should be even!\n");
+        MPI_Finalize();
+        return 1;
+    }
+
+    const int n       = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int repeats = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    if (rank == 0)printf("%d ranks, %d records, %d repeats\n", size, n, repeats);
+
+    bench<Particle>("Particle", n, repeats, rank);
+    bench<Record>  ("Record",   n, repeats, rank);
+    bench<Padded>  ("Padded",   n, repeats, rank);
+
+    MPI_Finalize();
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <cstdio> // printf
+#include <cstdlib> // atoi
+#include <vector>
+#include "MPIComm.hpp"
+
+//
+// Per-iteration latency of exchanging the same buffer of records every iteration:
+//   bcast      : blocking MPI_Bcast, as TestMPITypes.cpp,
+//   ibcast     : mpi::ibcast + MPI_Wait,
+//   persistent : mpi::persistent_bcast, start + wait,
+// and of a ring exchange by MPI_Sendrecv against mpi::persistent_send/recv.
+//
+// mpicxx -std=c++20 -O2 -I.. BenchPersistent.cpp -o BenchPersistent
+// mpirun -np 4 ./BenchPersistent [num_records] [iterations]
+//
+
+struct A{
+    double a0{};
+    int    a1[2]{};
+    char   a2{};
+};
+
+//! @brief run \f \iterations times, return the max time in us per iteration over all ranks.
+template<typename F>
+double latency(int iterations, F&& f)
+{
+    f(); // warm up
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double t0 = MPI_Wtime();
+    for (int i = 0; i < iterations; ++i)f();
+    const double t = (MPI_Wtime() - t0) / iterations * 1e6;
+
+    double tmax = 0;
+    MPI_Allreduce(&t, &tmax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return tmax;
+}
+
+int main(int argc, char** argv)
+{
+    int rank = 0, size = 0;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    const int n          = argc > 1 ? std::atoi(argv[1]) : 100;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 10000;
+
+    mpi::prewarm<A>();
+
+    std::vector<A> data(n), halo(n);
+    {
+        const double t_bcast = latency(iterations, [&] {
+            MPI_Bcast(data.data(), n, mpi::Data<A>::type(), 0, MPI_COMM_WORLD);
+            });
+
+        const double t_ibcast = latency(iterations, [&] {
+            MPI_Request request = mpi::ibcast(std::span<A>(data), 0, MPI_COMM_WORLD);
+            MPI_Wait(&request, MPI_STATUS_IGNORE);
+            });
+
+        auto bcast = mpi::persistent_bcast(std::span<A>(data), 0, MPI_COMM_WORLD);
+        const double t_persistent = latency(iterations, [&] {
+            bcast.start();
+            bcast.wait();
+            });
+
+        if (rank == 0)
+            printf("%d ranks, %d records, %d iterations\n"
+                "bcast : blocking %7.2f us  ibcast %7.2f us  persistent %7.2f us\n",
+                size, n, iterations, t_bcast, t_ibcast, t_persistent);
+    }
+    {
+        const int next = (rank + 1) % size, prev = (rank + size - 1) % size;
+
+        const double t_sendrecv = latency(iterations, [&] {
+            MPI_Sendrecv(data.data(), n, mpi::Data<A>::type(), next, 0,
+                halo.data(), n, mpi::Data<A>::type(), prev, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            });
+
+        mpi::persistent_request ring[2] = {
+            mpi::persistent_recv(std::span<A>(halo), prev, 0, MPI_COMM_WORLD),
+            mpi::persistent_send(std::span<const A>(data), next, 0, MPI_COMM_WORLD)
+        };
+        const double t_persistent = latency(iterations, [&] {
+            mpi::persistent_request::start_all(ring);
+            mpi::persistent_request::wait_all(ring);
+            });
+
+        if (rank == 0)
+            printf("ring  : sendrecv %7.2f us  persistent %7.2f us\n", t_sendrecv, t_persistent);
+    }
+
+    MPI_Finalize();
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+//!
+//! @brief   Persistent and nonblocking communication of spans of user defined struct.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! The datatype and the request are set up once and restarted every iteration:
+//!
+//!   auto send = mpi::persistent_send(std::span<const A>(a), peer, tag, comm);
+//!   for (...) {
+//!       send.start();
+//!       compute();  // overlapped with communication
+//!       send.wait();
+//!   }
+//!
+//! Persistent collectives use MPI_Bcast_init/MPI_Allgather_init of MPI-4 if available,
+//! otherwise MPI_Ibcast/MPI_Iallgather is restarted by start().
+//!
+
+#pragma once
+#include <span>
+#include <utility> // exchange
+#include <vector>
+
+#include "MPITypes.hpp"
+
+namespace mpi {
+
+    //! @brief persistent request, it should be destroyed before MPI_Finalize.
+    class persistent_request
+    {
+    public:
+        using restart_fn = void (*)(const persistent_request&, MPI_Request*);
+
+        persistent_request() = default;
+
+        persistent_request(const persistent_request&) = delete;
+        persistent_request& operator = (const persistent_request&) = delete;
+
+        persistent_request(persistent_request&& other)noexcept { swap(other); }
+
+        persistent_request& operator = (persistent_request&& other)noexcept
+        {
+            persistent_request(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~persistent_request()
+        {
+            if (request_ != MPI_REQUEST_NULL) {
+                if (restart_ != nullptr)MPI_Wait(&request_, MPI_STATUS_IGNORE); // nonblocking collective in flight
+                else MPI_Request_free(&request_);
+            }
+        }
+
+        //! @brief Start the communication.
+        void start()noexcept
+        {
+            if (restart_ != nullptr)restart_(*this, &request_);
+            else MPI_Start(&request_);
+        }
+
+        //! @brief Wait for the communication started by start().
+        void wait()noexcept
+        {
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+        }
+
+        //! @brief Whether or not the communication started by start() is completed.
+        bool test()noexcept
+        {
+            int flag = 0;
+            MPI_Test(&request_, &flag, MPI_STATUS_IGNORE);
+            return flag != 0;
+        }
+
+        //! @brief Start all requests by one MPI_Startall, e.g. the sends and receives of a halo exchange,
+        //!        the nonblocking collectives replacing persistent collectives are restarted one by one.
+        static void start_all(std::span<persistent_request> requests)noexcept
+        {
+            with_handles_(requests, [](const persistent_request& r) { return r.restart_ == nullptr; },
+                [](int n, MPI_Request* handles) { MPI_Startall(n, handles); });
+            for (auto& r : requests)
+                if (r.restart_ != nullptr)r.start();
+        }
+
+        //! @brief Wait for all requests by one MPI_Waitall.
+        static void wait_all(std::span<persistent_request> requests)noexcept
+        {
+            with_handles_(requests, [](const persistent_request&) { return true; },
+                [](int n, MPI_Request* handles) { MPI_Waitall(n, handles, MPI_STATUSES_IGNORE); });
+        }
+
+        void swap(persistent_request& other)noexcept
+        {
+            std::swap(request_, other.request_);
+            std::swap(restart_, other.restart_);
+            std::swap(sendbuf_, other.sendbuf_);
+            std::swap(recvbuf_, other.recvbuf_);
+            std::swap(count_, other.count_);
+            std::swap(type_, other.type_);
+            std::swap(rank_, other.rank_);
+            std::swap(comm_, other.comm_);
+        }
+
+    private:
+        //! @brief call \f(n, handles) with the handles of the requests selected by \pred,
+        //!        then copy the handles back, e.g. completed nonblocking requests become MPI_REQUEST_NULL.
+        template<typename Pred, typename F>
+        static void with_handles_(std::span<persistent_request> requests, Pred pred, F f)noexcept
+        {
+            constexpr std::size_t small_size = 16;
+            MPI_Request small[small_size];
+            std::vector<MPI_Request> large;
+            MPI_Request* handles = small;
+            if (requests.size() > small_size) {
+                large.resize(requests.size());
+                handles = large.data();
+            }
+
+            int n = 0;
+            for (auto& r : requests)
+                if (pred(r))handles[n++] = r.request_;
+            if (n == 0)return;
+            f(n, handles);
+
+            n = 0;
+            for (auto& r : requests)
+                if (pred(r))r.request_ = handles[n++];
+        }
+
+        template<typename T> friend persistent_request persistent_send(std::span<const T>, int, int, MPI_Comm)noexcept;
+        template<typename T> friend persistent_request persistent_recv(std::span<T>, int, int, MPI_Comm)noexcept;
+        template<typename T> friend persistent_request persistent_bcast(std::span<T>, int, MPI_Comm)noexcept;
+        template<typename T> friend persistent_request persistent_allgather(std::span<const T>, std::span<T>, MPI_Comm)noexcept;
+
+        MPI_Request request_ = MPI_REQUEST_NULL;
+
+        // arguments of the nonblocking collective restarted by start() if persistent collective is unavailable
+        restart_fn  restart_ = nullptr;
+        const void* sendbuf_ = nullptr;
+        void*       recvbuf_ = nullptr;
+        int         count_   = 0;
+        Datatype    type_    = MPI_DATATYPE_NULL;
+        int         rank_    = 0;
+        MPI_Comm    comm_    = MPI_COMM_NULL;
+    };
+
+    //! @brief Set up a persistent send of \data to \dest.
+    template<typename T>
+    inline persistent_request persistent_send(std::span<const T> data, int dest, int tag, MPI_Comm comm)noexcept
+    {
+        persistent_request r;
+        MPI_Send_init(data.data(), static_cast<int>(data.size()), Data<T>::type(), dest, tag, comm, &r.request_);
+        return r;
+    }
+
+    //! @brief Set up a persistent receive of \data from \source.
+    template<typename T>
+    inline persistent_request persistent_recv(std::span<T> data, int source, int tag, MPI_Comm comm)noexcept
+    {
+        persistent_request r;
+        MPI_Recv_init(data.data(), static_cast<int>(data.size()), Data<T>::type(), source, tag, comm, &r.request_);
+        return r;
+    }
+
+    //! @brief Set up a persistent broadcast of \data from \root.
+    template<typename T>
+    inline persistent_request persistent_bcast(std::span<T> data, int root, MPI_Comm comm)noexcept
+    {
+        persistent_request r;
+#if MPI_VERSION >= 4
+        MPI_Bcast_init(data.data(), static_cast<int>(data.size()), Data<T>::type(), root, comm, MPI_INFO_NULL, &r.request_);
+#else
+        r.recvbuf_ = data.data();
+        r.count_   = static_cast<int>(data.size());
+        r.type_    = Data<T>::type();
+        r.rank_    = root;
+        r.comm_    = comm;
+        r.restart_ = [](const persistent_request& self, MPI_Request* request) {
+            MPI_Ibcast(self.recvbuf_, self.count_, self.type_, self.rank_, self.comm_, request);
+            };
+#endif
+        return r;
+    }
+
+    //! @brief Set up a persistent allgather, every rank sends \send and \recv has send.size() records per rank.
+    template<typename T>
+    inline persistent_request persistent_allgather(std::span<const T> send, std::span<T> recv, MPI_Comm comm)noexcept
+    {
+        persistent_request r;
+        const int count = static_cast<int>(send.size());
+#if MPI_VERSION >= 4
+        MPI_Allgather_init(send.data(), count, Data<T>::type(), recv.data(), count, Data<T>::type(), comm, MPI_INFO_NULL, &r.request_);
+#else
+        r.sendbuf_ = send.data();
+        r.recvbuf_ = recv.data();
+        r.count_   = count;
+        r.type_    = Data<T>::type();
+        r.comm_    = comm;
+        r.restart_ = [](const persistent_request& self, MPI_Request* request) {
+            MPI_Iallgather(self.sendbuf_, self.count_, self.type_, self.recvbuf_, self.count_, self.type_, self.comm_, request);
+            };
+#endif
+        return r;
+    }
+
+    //! @brief Nonblocking broadcast of \data from \root.
+    template<typename T>
+    inline MPI_Request ibcast(std::span<T> data, int root, MPI_Comm comm)noexcept
+    {
+        MPI_Request request = MPI_REQUEST_NULL;
+        MPI_Ibcast(data.data(), static_cast<int>(data.size()), Data<T>::type(), root, comm, &request);
+        return request;
+    }
+
+    //! @brief Nonblocking allgather, every rank sends \send and \recv has send.size() records per rank.
+    template<typename T>
+    inline MPI_Request iallgather(std::span<const T> send, std::span<T> recv, MPI_Comm comm)noexcept
+    {
+        MPI_Request request = MPI_REQUEST_NULL;
+        const int count = static_cast<int>(send.size());
+        MPI_Iallgather(send.data(), count, Data<T>::type(), recv.data(), count, Data<T>::type(), comm, &request);
+        return request;
+    }
+}
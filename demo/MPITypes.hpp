@@ -6,9 +6,14 @@
 //!
 
 #pragma once
+#include <atomic>
 #include <cstddef>  // byte
 #include <type_traits>
+#include <array>
 #include <complex>
+#include <mutex>
+#include <tuple>
+#include <vector>
 #include <mpi.h>
 
 #include "struct_traits.hpp"
@@ -17,7 +22,7 @@ namespace mpi {
 
     using Datatype = MPI_Datatype;
 
-    template<typename T> struct Data;
+    template<typename T, std::size_t... Fields> struct Data;
 
     template<typename T>
     concept arithmetic_type = std::is_arithmetic_v<T>;
@@ -25,6 +30,27 @@ namespace mpi {
     template<typename T>
     concept array_type = std::is_array_v<T>;
 
+    namespace detail {
+        template<typename T> struct is_std_array_ : std::false_type {};
+        template<typename T, std::size_t N> struct is_std_array_<std::array<T, N>> : std::true_type {};
+
+        template<typename T> struct is_complex_ : std::false_type {};
+        template<typename T> struct is_complex_<std::complex<T>> : std::true_type {};
+
+        template<typename T> struct is_pair_ : std::false_type {};
+        template<typename T1, typename T2> struct is_pair_<std::pair<T1, T2>> : std::true_type {};
+    }
+
+    //! @brief std::array is aggregate, but its fields can NOT be accessed by struct_traits.
+    template<typename T>
+    concept std_array_type = zhb::aggregate<T> && detail::is_std_array_<T>::value;
+
+    template<typename T>
+    concept complex_type = detail::is_complex_<T>::value;
+
+    template<typename T>
+    concept pair_type = detail::is_pair_<T>::value;
+
     //! @brief pre-defined arithmetic type: char, int, float,...
     template<arithmetic_type T>
     struct Data<T>
@@ -64,36 +90,241 @@ namespace mpi {
 
         template<typename T> constexpr bool is_valid_() { return false; }
 
+        template<aggregate T> constexpr bool is_valid_();
+
         template<arithmetic_type T>
         constexpr bool is_valid_() { return true; }
 
+        template<complex_type T>
+        constexpr bool is_valid_() { return true; }
+
         template<array_type T>
         constexpr bool is_valid_() { return is_valid_<std::remove_all_extents_t<T>>(); }
 
+        template<std_array_type T>
+        constexpr bool is_valid_() { return is_valid_<typename T::value_type>(); }
+
+        template<pair_type T>
+        constexpr bool is_valid_() { return is_valid_<typename T::first_type>() && is_valid_<typename T::second_type>(); }
+
         template<aggregate T, std::size_t Field = 0>
         constexpr bool is_all_field_valid_()
         {
-            using type_i = struct_traits<T>::template field<Field>::type;
+            using type_i = zhb::field_type_t<T, Field>;
 
-            if constexpr (std::is_array_v<type_i>) {
-                if constexpr (!is_valid_<std::remove_all_extents_t<type_i>>())
-                    return false;
-            }
-            else if constexpr (!is_valid_<type_i>()) {
+            if constexpr (!is_valid_<type_i>())
                 return false;
-            }
-
-            if constexpr (Field + 1 < zhb::num_fields_v<T>)
+            else if constexpr (Field + 1 < zhb::num_fields_v<T>)
                 return is_all_field_valid_<T, Field + 1>();
             else
                 return true;
         }
 
+        //! @brief nested struct is valid if all of its fields are valid.
         template<aggregate T>
         constexpr bool is_valid_() { return is_all_field_valid_<T>(); }
+
+        template<>
+        constexpr bool is_valid_<std::byte>() { return true; }
+
+        //! @brief make sure the extent of \type is \size_in_bytes, so that arrays of the type are strided by it.
+        inline void resize_(Datatype& type, MPI_Aint size_in_bytes)noexcept
+        {
+            MPI_Aint lb, ext;
+            MPI_Type_get_extent(type, &lb, &ext);
+            if (lb == 0 && ext == size_in_bytes)return;
+
+            Datatype resized = MPI_DATATYPE_NULL;
+            MPI_Type_create_resized(type, 0, size_in_bytes, &resized);
+            MPI_Type_free(&type);
+            type = resized;
+        }
+
+        //! @brief created datatypes and ops, every one is created exactly once and freed at MPI_Finalize.
+        //! @note  the lookup is lock-free after creation, creation is serialized by a recursive mutex
+        //!        since the datatype of nested struct is created when creating the outer one.
+        struct registry_
+        {
+            inline static std::recursive_mutex                mutex_;
+            inline static std::vector<std::atomic<Datatype>*> types_;
+            inline static std::vector<std::atomic<MPI_Op>*>   ops_;
+            inline static int                                 keyval_ = MPI_KEYVAL_INVALID;
+
+            //! @brief get the datatype in \slot, or create and commit it by \create.
+            template<typename Create>
+            inline static Datatype type(std::atomic<Datatype>& slot, Create&& create)
+            {
+                Datatype type = slot.load(std::memory_order_acquire);
+                if (type != MPI_DATATYPE_NULL)return type;
+
+                std::lock_guard lock(mutex_);
+                type = slot.load(std::memory_order_relaxed);
+                if (type != MPI_DATATYPE_NULL)return type;
+
+                watch_finalize_();
+                type = create();
+                types_.push_back(&slot);
+                slot.store(type, std::memory_order_release);
+                return type;
+            }
+
+            //! @brief get the op in \slot, or create it by \create.
+            template<typename Create>
+            inline static MPI_Op op(std::atomic<MPI_Op>& slot, Create&& create)
+            {
+                MPI_Op op = slot.load(std::memory_order_acquire);
+                if (op != MPI_OP_NULL)return op;
+
+                std::lock_guard lock(mutex_);
+                op = slot.load(std::memory_order_relaxed);
+                if (op != MPI_OP_NULL)return op;
+
+                watch_finalize_();
+                op = create();
+                ops_.push_back(&slot);
+                slot.store(op, std::memory_order_release);
+                return op;
+            }
+
+            //! @brief free all created datatypes and ops, they will be created again if used later.
+            inline static void free_all()noexcept
+            {
+                std::lock_guard lock(mutex_);
+                for (auto slot = types_.rbegin(); slot != types_.rend(); ++slot) {
+                    Datatype type = (*slot)->exchange(MPI_DATATYPE_NULL);
+                    MPI_Type_free(&type);
+                }
+                for (auto slot : ops_) {
+                    MPI_Op op = slot->exchange(MPI_OP_NULL);
+                    MPI_Op_free(&op);
+                }
+                types_.clear();
+                ops_.clear();
+            }
+
+        private:
+            //! @brief attributes of MPI_COMM_SELF are deleted at the beginning of MPI_Finalize.
+            inline static int on_finalize_(MPI_Comm, int, void*, void*)
+            {
+                free_all();
+                return MPI_SUCCESS;
+            }
+
+            inline static void watch_finalize_()noexcept
+            {
+                if (keyval_ != MPI_KEYVAL_INVALID)return;
+                MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, &on_finalize_, &keyval_, nullptr);
+                MPI_Comm_set_attr(MPI_COMM_SELF, keyval_, nullptr);
+            }
+        };
+
+        //! @brief whether or not \T is a dense array of ONE pre-defined type without padding,
+        //!        e.g. struct { double x, y, z; } is the same as double[3].
+        template<typename T>
+        struct uniform_
+        {
+            inline static constexpr bool value = false;
+            using type = void;
+            inline static constexpr std::size_t count = 0;
+            inline static constexpr std::size_t bytes = 0;
+        };
+
+        template<typename T>
+            requires arithmetic_type<T> || complex_type<T> || std::is_same_v<T, std::byte>
+        struct uniform_<T>
+        {
+            inline static constexpr bool value = !std::is_same_v<T, bool>;
+            using type = T;
+            inline static constexpr std::size_t count = 1;
+            inline static constexpr std::size_t bytes = sizeof(T);
+        };
+
+        template<typename T, std::size_t N>
+        struct uniform_<T[N]> : uniform_<T>
+        {
+            inline static constexpr std::size_t count = uniform_<T>::count * N;
+            inline static constexpr std::size_t bytes = uniform_<T>::bytes * N;
+        };
+
+        template<typename T, std::size_t N>
+        struct uniform_<std::array<T, N>> : uniform_<T[N]> {};
+
+        template<aggregate T, typename Indices> struct uniform_fields_;
+
+        template<aggregate T, std::size_t... I>
+        struct uniform_fields_<T, std::index_sequence<I...>>
+        {
+            using type = typename uniform_<zhb::field_type_t<T, 0>>::type;
+
+            inline static constexpr bool value = (uniform_<zhb::field_type_t<T, I>>::value && ...)
+                && (std::is_same_v<typename uniform_<zhb::field_type_t<T, I>>::type, type> && ...)
+                && (uniform_<zhb::field_type_t<T, I>>::bytes + ...) == sizeof(T);
+
+            inline static constexpr std::size_t count = (uniform_<zhb::field_type_t<T, I>>::count + ...);
+            inline static constexpr std::size_t bytes = (uniform_<zhb::field_type_t<T, I>>::bytes + ...);
+        };
+
+        template<aggregate T> requires (zhb::num_fields_v<T> > 0)
+        struct uniform_<T> : uniform_fields_<T, std::make_index_sequence<zhb::num_fields_v<T>>> {};
+
+        //! @brief block of the field \I of \T for MPI_Type_create_struct, \ext is the extent of ONE element of the block.
+        template<aggregate T, std::size_t I>
+        inline void field_block_(int& len, MPI_Aint& dsp, Datatype& typ, MPI_Aint& ext)noexcept
+        {
+            using type_i = zhb::field_type_t<T, I>;
+            using elem_i = std::remove_all_extents_t<type_i>;
+
+            if constexpr (uniform_<type_i>::value) {
+                // nested struct without padding is a block of its pre-defined type
+                using base_i = typename uniform_<type_i>::type;
+                len = uniform_<type_i>::count;
+                typ = Data<base_i>::type();
+                ext = sizeof(base_i);
+            }
+            else {
+                // array of struct is one block of the datatype of the struct
+                len = sizeof(type_i) / sizeof(elem_i);
+                typ = Data<elem_i>::type();
+                ext = sizeof(elem_i);
+            }
+            dsp = zhb::offsets_v<T>[I];
+        }
+
+        //! @brief get the blocks of the fields \I..., one block per field.
+        template<aggregate T, std::size_t... I>
+        inline void field_blocks_(int len[], MPI_Aint dsp[], Datatype typ[], MPI_Aint ext[])noexcept
+        {
+            std::size_t k = 0;
+            ((field_block_<T, I>(len[k], dsp[k], typ[k], ext[k]), ++k), ...);
+        }
+
+        //! @brief merge adjacent blocks of the same type in place.
+        //! @return number of blocks after merging.
+        inline int merge_blocks_(int n, int len[], MPI_Aint dsp[], Datatype typ[], MPI_Aint ext[])noexcept
+        {
+            int m = 0;
+            for (int i = 0; i < n; ++i) {
+                if (m > 0 && typ[m - 1] == typ[i] && dsp[m - 1] + len[m - 1] * ext[m - 1] == dsp[i]) {
+                    len[m - 1] += len[i];
+                    continue;
+                }
+                len[m] = len[i];
+                dsp[m] = dsp[i];
+                typ[m] = typ[i];
+                ext[m] = ext[i];
+                ++m;
+            }
+            return m;
+        }
     }
 
-    //! @brief user defined struct
+    //! @brief user defined struct, nested struct and array of struct are supported,
+    //!        the datatype of nested struct is created once and reused.
+    //! @note  type() is optimized for the generic pack/unpack of MPI:
+    //!        1) struct without padding of ONE pre-defined type is MPI_Type_contiguous of the type,
+    //!        2) otherwise adjacent fields of the same type are merged into one block,
+    //!           and nested struct without padding is a block of its pre-defined type.
+    //!        byte_type() can be used instead if all ranks are known to be homogeneous.
     template<aggregate T>
     struct Data<T>
     {
@@ -127,51 +358,113 @@ namespace mpi {
                     return MPI_C_LONG_DOUBLE_COMPLEX;
             }
 
-            static Datatype type_ = MPI_DATATYPE_NULL;
-            if (type_ != MPI_DATATYPE_NULL)return type_;
-
-            // create new type
-
-            int      block_len[num_fields];
-            MPI_Aint block_dsp[num_fields];
-            Datatype block_typ[num_fields];
-
-            get_info_<0>(block_len, block_dsp, block_typ);
-
-            MPI_Type_create_struct(num_fields, block_len, block_dsp, block_typ, &type_);
-
-            MPI_Aint lb, ext;
-            MPI_Type_get_extent(type_, &lb, &ext);
-            if (ext - lb != size_in_bytes)
-                MPI_Type_create_resized(type_, 0, size_in_bytes, &type_);
+            static std::atomic<Datatype> type_{ MPI_DATATYPE_NULL };
+            return detail::registry_::type(type_, [] {
+                Datatype type = MPI_DATATYPE_NULL;
+                if constexpr (detail::uniform_<T>::value) {
+                    MPI_Type_contiguous(detail::uniform_<T>::count, Data<typename detail::uniform_<T>::type>::type(), &type);
+                }
+                else {
+                    int      block_len[num_fields];
+                    MPI_Aint block_dsp[num_fields];
+                    Datatype block_typ[num_fields];
+                    MPI_Aint block_ext[num_fields];
+
+                    get_info_(block_len, block_dsp, block_typ, block_ext, std::make_index_sequence<num_fields>{});
+
+                    const int nblock = detail::merge_blocks_(num_fields, block_len, block_dsp, block_typ, block_ext);
+
+                    MPI_Type_create_struct(nblock, block_len, block_dsp, block_typ, &type);
+                    detail::resize_(type, size_in_bytes);
+                }
+                MPI_Type_commit(&type);
+                return type;
+            });
+        }
 
-            MPI_Type_commit(&type_);
+        //! @brief MPI_Type_create_struct with one block per field, i.e. without optimization of type().
+        static Datatype struct_type()noexcept
+        {
+            static std::atomic<Datatype> type_{ MPI_DATATYPE_NULL };
+            return detail::registry_::type(type_, [] {
+                Datatype type = MPI_DATATYPE_NULL;
+                int      block_len[num_fields];
+                MPI_Aint block_dsp[num_fields];
+                Datatype block_typ[num_fields];
+                MPI_Aint block_ext[num_fields];
+
+                get_info_(block_len, block_dsp, block_typ, block_ext, std::make_index_sequence<num_fields>{});
+
+                MPI_Type_create_struct(num_fields, block_len, block_dsp, block_typ, &type);
+                detail::resize_(type, size_in_bytes);
+                MPI_Type_commit(&type);
+                return type;
+            });
+        }
 
-            return type_;
+        //! @brief contiguous MPI_BYTE of sizeof(T), padding bytes included.
+        //! @note  only valid if all ranks are homogeneous, i.e. the same byte order and layout of \T.
+        static Datatype byte_type()noexcept
+        {
+            static std::atomic<Datatype> type_{ MPI_DATATYPE_NULL };
+            return detail::registry_::type(type_, [] {
+                Datatype type = MPI_DATATYPE_NULL;
+                MPI_Type_contiguous(size_in_bytes, MPI_BYTE, &type);
+                MPI_Type_commit(&type);
+                return type;
+            });
         }
 
     private:
-        template<size_t I = 0>
-        static void get_info_(int block_len[], MPI_Aint block_dsp[], Datatype block_typ[])noexcept
+        template<std::size_t... I>
+        static void get_info_(int block_len[], MPI_Aint block_dsp[], Datatype block_typ[], MPI_Aint block_ext[], std::index_sequence<I...>)noexcept
         {
-            using type_i = struct_traits<T>::template field<I>::type;
-            
-            if constexpr (!std::is_array_v<type_i>) {
-                block_len[I] = 1;
-                block_typ[I] = Data<type_i>::type();
-            }
-            else {
-                block_len[I] = sizeof(type_i) / sizeof(std::remove_all_extents_t<type_i>);
-                block_typ[I] = Data<std::remove_all_extents_t<type_i>>::type();
-            }
+            detail::field_blocks_<T, I...>(block_len, block_dsp, block_typ, block_ext);
+        }
+    };
 
-            block_dsp[I] = struct_traits<T>::field<I>::offset();
+    //! @brief subset of the fields of user defined struct, e.g. Data<A, 0, 4> sends only the fields 0 and 4 of A.
+    //! @note  the extent is resized to sizeof(T), so that the fields are gathered from/scattered to an array of \T
+    //!        directly, no staging copy is needed.
+    template<aggregate T, std::size_t... Fields> requires (sizeof...(Fields) > 0)
+    struct Data<T, Fields...>
+    {
+        static_assert(detail::is_valid_<T>(), "some field(s) is unsupported!");
+        static_assert(((Fields < zhb::num_fields_v<T>) && ...), "field index is out of range!");
 
-            if constexpr (I + 1 < num_fields)
-                get_info_<I + 1>(block_len, block_dsp, block_typ);
+        static constexpr auto size_in_bytes = sizeof(T);
+
+        static constexpr auto num_fields = sizeof...(Fields);
+
+        static Datatype type()noexcept
+        {
+            static std::atomic<Datatype> type_{ MPI_DATATYPE_NULL };
+            return detail::registry_::type(type_, [] {
+                Datatype type = MPI_DATATYPE_NULL;
+                int      block_len[num_fields];
+                MPI_Aint block_dsp[num_fields];
+                Datatype block_typ[num_fields];
+                MPI_Aint block_ext[num_fields];
+
+                detail::field_blocks_<T, Fields...>(block_len, block_dsp, block_typ, block_ext);
+
+                const int nblock = detail::merge_blocks_(num_fields, block_len, block_dsp, block_typ, block_ext);
+
+                MPI_Type_create_struct(nblock, block_len, block_dsp, block_typ, &type);
+                detail::resize_(type, size_in_bytes);
+                MPI_Type_commit(&type);
+                return type;
+            });
         }
     };
 
+    //! @brief datatype of the fields \Fields... of \T, the same as Data<T, Fields...>::type().
+    template<std::size_t... Fields, aggregate T>
+    inline Datatype select(const T*)noexcept
+    {
+        return Data<T, Fields...>::type();
+    }
+
     //! @brief array type
     template<array_type T>
     struct Data<T>
@@ -185,19 +478,24 @@ namespace mpi {
 
         inline static Datatype type()
         {
-            static Datatype type_ = MPI_DATATYPE_NULL;
-            if (type_ != MPI_DATATYPE_NULL)return type_;
-
-            // create new type
-
-            constexpr auto numel = sizeof(T) / sizeof(elem_type);
-            MPI_Type_vector(1, numel, size_in_bytes, Data<elem_type>::type(), &type_);
-            MPI_Type_commit(&type_);
-
-            return type_;
+            static std::atomic<Datatype> type_{ MPI_DATATYPE_NULL };
+            return detail::registry_::type(type_, [] {
+                Datatype type = MPI_DATATYPE_NULL;
+                constexpr auto numel = sizeof(T) / sizeof(elem_type);
+                MPI_Type_vector(1, numel, size_in_bytes, Data<elem_type>::type(), &type);
+                MPI_Type_commit(&type);
+                return type;
+            });
         }
     };
 
+    //! @brief std::array, the same as built-in array
+    template<typename T, std::size_t N>
+    struct Data<std::array<T, N>> : Data<T[N]>
+    {
+        static_assert(sizeof(std::array<T, N>) == sizeof(T[N]), "std::array has padding!");
+    };
+
     //! @brief std::pair
     template<typename first, typename second>
     struct Data<std::pair<first, second>>
@@ -228,24 +526,19 @@ namespace mpi {
             else if constexpr (std::is_same_v<first, long double> && std::is_same_v<second, long double>)
                 return MPI_C_LONG_DOUBLE_COMPLEX;
             else {
-                static Datatype type_ = MPI_DATATYPE_NULL;
-                if (type_ != MPI_DATATYPE_NULL)return type_;
-
-                // create new type
-
-                using T = std::pair<first, second>;
-                int      block_len[2] = { 1,1 };
-                MPI_Aint block_dsp[2] = { 0, offsetof(T, second)};
-                Datatype block_typ[2] = { Data<first>::type(), Data<second>::type() };
-
-                MPI_Type_create_struct(2, block_len, block_dsp, block_typ, &type_);
-
-                MPI_Aint lb, ext;
-                MPI_Type_get_extent(type_, &lb, &ext);
-                if (ext - lb != size_in_bytes)
-                    MPI_Type_create_resized(type_, 0, size_in_bytes, &type_);
-
-                MPI_Type_commit(&type_);
+                static std::atomic<Datatype> type_{ MPI_DATATYPE_NULL };
+                return detail::registry_::type(type_, [] {
+                    Datatype type = MPI_DATATYPE_NULL;
+                    using T = std::pair<first, second>;
+                    int      block_len[2] = { 1,1 };
+                    MPI_Aint block_dsp[2] = { 0, offsetof(T, second)};
+                    Datatype block_typ[2] = { Data<first>::type(), Data<second>::type() };
+
+                    MPI_Type_create_struct(2, block_len, block_dsp, block_typ, &type);
+                    detail::resize_(type, size_in_bytes);
+                    MPI_Type_commit(&type);
+                    return type;
+                });
             }
         }
     };
@@ -265,4 +558,123 @@ namespace mpi {
             else if constexpr (std::is_same_v<Real, long double>)return MPI_C_LONG_DOUBLE_COMPLEX;
         }
     };
+
+    //! @brief reducers of mpi::Op, inout = reducer(in, inout).
+    //!        A reducer declaring `static constexpr bool commutative = true` lets MPI reorder the operands.
+    struct sum  { static constexpr bool commutative = true; template<typename U> constexpr U operator()(const U& a, const U& b)const noexcept { return a + b; } };
+    struct prod { static constexpr bool commutative = true; template<typename U> constexpr U operator()(const U& a, const U& b)const noexcept { return a * b; } };
+    struct min  { static constexpr bool commutative = true; template<typename U> constexpr U operator()(const U& a, const U& b)const noexcept { return b < a ? b : a; } };
+    struct max  { static constexpr bool commutative = true; template<typename U> constexpr U operator()(const U& a, const U& b)const noexcept { return a < b ? b : a; } };
+
+    //! @brief one reducer per field, e.g. per_field<sum, sum, min, max>.
+    template<typename... Reducers> struct per_field {};
+
+    namespace detail {
+
+        //! @brief reducer of the field \I.
+        template<typename Reducer, std::size_t I>
+        struct field_reducer_ { using type = Reducer; };
+
+        template<typename... Reducers, std::size_t I>
+        struct field_reducer_<per_field<Reducers...>, I> { using type = std::tuple_element_t<I, std::tuple<Reducers...>>; };
+
+        //! @brief whether or not there is one reducer per field.
+        template<typename Reducer, std::size_t N>
+        inline constexpr bool has_reducers_ = true;
+
+        template<typename... Reducers, std::size_t N>
+        inline constexpr bool has_reducers_<per_field<Reducers...>, N> = sizeof...(Reducers) == N;
+
+        //! @brief whether or not the reducer is commutative, false unless it declares `commutative = true`.
+        template<typename Reducer>
+        inline constexpr bool commutative_ = [] {
+            if constexpr (requires { { Reducer::commutative } -> std::convertible_to<bool>; })return bool(Reducer::commutative);
+            else return false;
+        }();
+
+        template<typename... Reducers>
+        inline constexpr bool commutative_<per_field<Reducers...>> = (commutative_<Reducers> && ...);
+
+        template<typename Reducer, typename U>
+        inline void reduce_value_(const Reducer& reducer, const U& in, U& inout)noexcept
+        {
+            if constexpr (std::is_array_v<U> || std_array_type<U>) {
+                for (std::size_t i = 0; i < std::size(in); ++i)
+                    reduce_value_(reducer, in[i], inout[i]);
+            }
+            else if constexpr (aggregate<U>) {
+                // nested struct, all of its fields are reduced by the same reducer
+                [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    (reduce_value_(reducer, struct_traits<U>::template get<I>(in), struct_traits<U>::template get<I>(inout)), ...);
+                }(std::make_index_sequence<zhb::num_fields_v<U>>{});
+            }
+            else {
+                inout = reducer(in, inout);
+            }
+        }
+    }
+
+    //! @brief user defined reduction of struct, every field is reduced by \Reducer (or per_field<...>) independently,
+    //!        e.g. MPI_Allreduce(in, out, n, Data<T>::type(), Op<T, per_field<sum, min, max>>::op(), comm).
+    //! @note  the datatype of the reduction should be the whole struct, i.e. Data<T>::type().
+    //!        The MPI_Op is commutative only if all the reducers are commutative, see detail::commutative_.
+    template<aggregate T, typename Reducer>
+    struct Op
+    {
+        static constexpr auto num_fields = zhb::num_fields_v<T>;
+
+        static_assert(detail::has_reducers_<Reducer, num_fields>, "number of reducers should be the same as fields!");
+
+        static MPI_Op op()noexcept
+        {
+            static std::atomic<MPI_Op> op_{ MPI_OP_NULL };
+            return detail::registry_::op(op_, [] {
+                MPI_Op op = MPI_OP_NULL;
+                MPI_Op_create(&apply_, detail::commutative_<Reducer> ? 1 : 0, &op);
+                return op;
+            });
+        }
+
+    private:
+        //! @brief MPI_User_function, the fields are reduced one by one over all records,
+        //!        so that the inner loop over records can be vectorized.
+        static void apply_(void* invec, void* inoutvec, int* len, MPI_Datatype*)
+        {
+            const T* in = static_cast<const T*>(invec);
+            T* inout = static_cast<T*>(inoutvec);
+            const int n = *len;
+
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((reduce_field_<I>(in, inout, n)), ...);
+            }(std::make_index_sequence<num_fields>{});
+        }
+
+        template<std::size_t I>
+        static void reduce_field_(const T* in, T* inout, int n)noexcept
+        {
+            const typename detail::field_reducer_<Reducer, I>::type reducer{};
+            for (int r = 0; r < n; ++r)
+                detail::reduce_value_(reducer, struct_traits<T>::template get<I>(in[r]), struct_traits<T>::template get<I>(inout[r]));
+        }
+    };
+
+    //! @brief Create the datatypes of \Ts... in one call, e.g. at startup before spawning threads,
+    //!        \Ts is a data type (Data<Ts>::type()) or Op<...> (Ts::op()).
+    template<typename... Ts>
+    inline void prewarm()
+    {
+        ([] {
+            if constexpr (requires { Ts::op(); })
+                Ts::op();
+            else
+                Data<Ts>::type();
+            }(), ...);
+    }
+
+    //! @brief Free all datatypes and ops created by this header.
+    //! @note  it is called at the beginning of MPI_Finalize automatically.
+    inline void free_types()noexcept
+    {
+        detail::registry_::free_all();
+    }
 }
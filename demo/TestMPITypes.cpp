@@ -1,4 +1,5 @@
 #include <cstdio> // printf
+#include <vector>
 #include "MPITypes.hpp"
 
 //
@@ -12,6 +13,26 @@ struct A{
     char   a2{};
 };
 
+// nested struct, array of struct, std::array and std::complex
+struct B{
+    A                    b0[2]{};
+    std::array<short, 3> b1{};
+    std::complex<float>  b2{};
+    long                 b3{};
+};
+
+// a non-commutative reducer, keeps the value of the lowest rank
+struct first { template<typename U> U operator()(const U& a, const U&)const noexcept { return a; } };
+
+// statistics reduced by user defined MPI_Op
+struct Stats{
+    long   count{};
+    double sum{};
+    double min{};
+    double max{};
+    int    hist[4]{};
+};
+
 int main(int argc, char** argv)
 {
     int rank = 0;
@@ -19,6 +40,9 @@ int main(int argc, char** argv)
     MPI_Init(&argc, &argv);
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
+    // create all datatypes at startup, they are freed by MPI_Finalize
+    mpi::prewarm<A, B, Stats>();
+
     A a;
     if (rank == 0) {
         a.a0 = 1;
@@ -29,6 +53,43 @@ int main(int argc, char** argv)
 
     printf("[%d] a0=%lf, a1={%d,%d}, a2=%c\n", rank, a.a0, a.a1[0], a.a1[1], a.a2);
 
+    B b;
+    if (rank == 0) {
+        b.b0[1] = a;
+        b.b1 = { 4, 5, 6 };
+        b.b2 = { 7.0f, 8.0f };
+        b.b3 = 9;
+    }
+    MPI_Bcast(&b, 1, mpi::Data<B>::type(), 0, MPI_COMM_WORLD); // the whole nested record in one collective
+
+    printf("[%d] b0[1].a2=%c, b1={%d,%d,%d}, b2=(%g,%g), b3=%ld\n", rank, b.b0[1].a2,
+        b.b1[0], b.b1[1], b.b1[2], b.b2.real(), b.b2.imag(), b.b3);
+
+    // only the fields a0 and a2 of each record, gathered from the array of A directly
+    std::vector<A> as(4);
+    if (rank == 0) {
+        for (int i = 0; i < 4; ++i)as[i] = A{ 10.0 * i, { -1, -1 }, char('a' + i) };
+    }
+    MPI_Bcast(as.data(), 4, mpi::Data<A, 0, 2>::type(), 0, MPI_COMM_WORLD);
+
+    printf("[%d] as[3]: a0=%lf, a1={%d,%d}, a2=%c\n", rank, as[3].a0, as[3].a1[0], as[3].a1[1], as[3].a2);
+
+    // field-wise reduction, no hand-written MPI_Op_create callback
+    Stats st{ 1, double(rank), double(rank), double(rank), { rank, 1, 0, 0 } }, total;
+    using StatsOp = mpi::Op<Stats, mpi::per_field<mpi::sum, mpi::sum, mpi::min, mpi::max, mpi::sum>>;
+    MPI_Allreduce(&st, &total, 1, mpi::Data<Stats>::type(), StatsOp::op(), MPI_COMM_WORLD);
+
+    printf("[%d] count=%ld, sum=%g, min=%g, max=%g, hist={%d,%d,%d,%d}\n", rank,
+        total.count, total.sum, total.min, total.max, total.hist[0], total.hist[1], total.hist[2], total.hist[3]);
+
+    // a reducer without `commutative = true` is applied in rank order
+    using FirstReducers = mpi::per_field<mpi::sum, first, mpi::min, mpi::max, mpi::sum>;
+    using FirstOp = mpi::Op<Stats, FirstReducers>;
+    static_assert(mpi::detail::commutative_<mpi::sum> && !mpi::detail::commutative_<FirstReducers>);
+    MPI_Allreduce(&st, &total, 1, mpi::Data<Stats>::type(), FirstOp::op(), MPI_COMM_WORLD);
+
+    printf("[%d] count=%ld, sum of rank 0=%g\n", rank, total.count, total.sum);
+
     MPI_Finalize();
 
     return 0;
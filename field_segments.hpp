@@ -0,0 +1,64 @@
+//!
+//! @brief   Runs of adjacent fields which can be processed as raw bytes, used by hash and compare.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+
+#pragma once
+#include "struct_traits.hpp"
+
+namespace zhb {
+    namespace detail
+    {
+        //! @brief whether or not the value is determined by its bytes, i.e. no padding and no floating point.
+        template<typename U>
+        inline constexpr bool has_unique_representation_ = std::has_unique_object_representations_v<U>;
+
+        //! @brief a run of adjacent fields.
+        struct field_segment_
+        {
+            std::size_t field;  //!< index of the first field, the run starts at its address.
+            std::size_t size;   //!< bytes of the run, 0 if the field should be processed by value.
+        };
+
+        //! @brief merge adjacent fields having unique object representation into runs of bytes,
+        //!        every other field is a segment of its own with size 0.
+        //! @note  fields are merged only if the layout of \T is proved (layout_supported_).
+        template<aggregate T>
+        struct field_segments_
+        {
+            inline static constexpr std::array<bool, num_fields_v<T>> unique = []<std::size_t... I>(std::index_sequence<I...>) {
+                return std::array<bool, num_fields_v<T>>{ has_unique_representation_<field_type_t<T, I>>... };
+            }(std::make_index_sequence<num_fields_v<T>>{});
+
+            inline static constexpr bool merged_(std::size_t i)noexcept
+            {
+                if constexpr (layout_supported_<T>)
+                    return i > 0 && unique[i] && unique[i - 1] && offsets_v<T>[i - 1] + sizes_v<T>[i - 1] == offsets_v<T>[i];
+                else
+                    return false;
+            }
+
+            inline static consteval std::size_t count_()noexcept
+            {
+                std::size_t n = 0;
+                for (std::size_t i = 0; i < num_fields_v<T>; ++i)
+                    if (!merged_(i))++n;
+                return n;
+            }
+
+            inline static constexpr std::array<field_segment_, count_()> segments = [] {
+                std::array<field_segment_, count_()> seg{};
+                std::size_t n = 0;
+                for (std::size_t i = 0; i < num_fields_v<T>; ++i) {
+                    if (merged_(i))
+                        seg[n - 1].size += sizes_v<T>[i];
+                    else
+                        seg[n++] = { i, unique[i] ? sizes_v<T>[i] : 0 };
+                }
+                return seg;
+            }();
+        };
+    }
+}
@@ -0,0 +1,174 @@
+//!
+//! @brief   Flatten nested aggregates and arrays of aggregates into a compile-time table of leaf fields.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! A leaf is a field (or element of array of aggregates) whose type is not aggregate, e.g. for
+//!
+//!   struct B { int b0; char b1; };
+//!   struct A { int a0[3]; double a1; char a2; B a3[2]; ... };
+//!
+//! the leaves are: int x 3 (a0), double (a1), char (a2), int (a3[0].b0), char (a3[0].b1), int (a3[1].b0), ...
+//! Arrays (and std::array) of non-aggregate type are ONE leaf with count = number of elements.
+//!
+
+#pragma once
+#include <cstddef>  // byte
+#include <new>      // launder
+#include <span>
+
+#include "struct_traits.hpp"
+
+namespace zhb {
+
+    //! @brief information of leaf field.
+    struct leaf_info
+    {
+        std::size_t offset; //!< offset in bytes in the top-level struct.
+        std::size_t size;   //!< size in bytes of ONE element.
+        std::size_t count;  //!< number of elements, > 1 if the leaf is array.
+    };
+
+    namespace detail
+    {
+        template<typename... Leaves> struct type_list_ {};
+
+        template<typename... L1, typename... L2>
+        type_list_<L1..., L2...> operator + (type_list_<L1...>, type_list_<L2...>);
+
+        //! @brief a leaf of \Count elements of type \U at \Offset.
+        template<typename U, std::size_t Offset, std::size_t Count>
+        struct leaf_
+        {
+            using type = U;
+            inline static constexpr std::size_t offset = Offset;
+            inline static constexpr std::size_t count  = Count;
+        };
+
+        template<typename U, std::size_t Offset> struct flatten_;
+
+        template<typename U, std::size_t Offset, typename Indices> struct flatten_fields_;
+        template<typename U, std::size_t Offset, typename Indices> struct flatten_elements_;
+
+        //! @brief non-aggregate field, or array of them.
+        template<typename U, std::size_t Offset>
+        struct flatten_
+        {
+            using elem_type = std::remove_all_extents_t<U>;
+            using type = type_list_<leaf_<elem_type, Offset, sizeof(U) / sizeof(elem_type)>>;
+        };
+
+        //! @brief array of aggregates, every element is expanded.
+        template<typename U, std::size_t N, std::size_t Offset>
+            requires aggregate<std::remove_all_extents_t<U>>
+        struct flatten_<U[N], Offset>
+        {
+            using elem_type = std::remove_all_extents_t<U>;
+            using type = typename flatten_elements_<elem_type, Offset, std::make_index_sequence<sizeof(U[N]) / sizeof(elem_type)>>::type;
+        };
+
+        //! @brief aggregate, every field is expanded.
+        template<aggregate U, std::size_t Offset>
+        struct flatten_<U, Offset>
+        {
+            using type = typename flatten_fields_<U, Offset, std::make_index_sequence<num_fields_v<U>>>::type;
+        };
+
+        //! @brief std::array is decomposed by tuple protocol rather than its member, flatten it as built-in array.
+        template<typename U, std::size_t N, std::size_t Offset>
+        struct flatten_<std::array<U, N>, Offset> : flatten_<U[N], Offset> {};
+
+        template<typename U, std::size_t Offset, std::size_t... I>
+        struct flatten_fields_<U, Offset, std::index_sequence<I...>>
+        {
+            using type = decltype((type_list_<>{} + ... + typename flatten_<field_type_t<U, I>, Offset + offsets_v<U>[I]>::type{}));
+        };
+
+        template<typename U, std::size_t Offset, std::size_t... I>
+        struct flatten_elements_<U, Offset, std::index_sequence<I...>>
+        {
+            using type = decltype((type_list_<>{} + ... + typename flatten_<U, Offset + I * sizeof(U)>::type{}));
+        };
+
+        template<std::size_t K, typename U> struct indexed_type_ { using type = U; };
+
+        template<typename Indices, typename... Ts> struct indexed_types_;
+
+        template<std::size_t... K, typename... Ts>
+        struct indexed_types_<std::index_sequence<K...>, Ts...> : indexed_type_<K, Ts>... {};
+
+        //! @brief select the K-th type by overload resolution.
+        template<std::size_t K, typename U>
+        indexed_type_<K, U> select_type_(const indexed_type_<K, U>&);
+
+        template<typename List> struct leaf_table_;
+
+        template<typename... Leaves>
+        struct leaf_table_<type_list_<Leaves...>>
+        {
+            inline static constexpr std::size_t num_leaves = sizeof...(Leaves);
+
+            inline static constexpr std::array<leaf_info, num_leaves> leaves = {
+                leaf_info{ Leaves::offset, sizeof(typename Leaves::type), Leaves::count }...
+            };
+
+            template<std::size_t K>
+            using leaf_type = typename decltype(select_type_<K>(indexed_types_<std::make_index_sequence<num_leaves>, Leaves...>{}))::type::type;
+
+            template<typename Byte, typename Visitor, std::size_t... K>
+            inline static void visit_(Byte* base, Visitor& visitor, std::index_sequence<K...>)
+            {
+                (visitor(std::span<std::conditional_t<std::is_const_v<Byte>, const typename Leaves::type, typename Leaves::type>, Leaves::count>(
+                    std::launder(reinterpret_cast<std::conditional_t<std::is_const_v<Byte>, const typename Leaves::type, typename Leaves::type>*>(base + Leaves::offset)),
+                    Leaves::count), std::integral_constant<std::size_t, K>{}), ...);
+            }
+        };
+    }
+
+    template<aggregate T>
+    struct flatten_traits
+    {
+    private:
+        using table_ = detail::leaf_table_<typename detail::flatten_<T, 0>::type>;
+
+    public:
+        //! @brief number of leaf fields.
+        inline static constexpr std::size_t num_leaves = table_::num_leaves;
+
+        //! @brief offset, size and count of all leaf fields.
+        inline static constexpr const std::array<leaf_info, num_leaves>& leaves = table_::leaves;
+
+        //! @brief type of ONE element of the K-th leaf.
+        template<std::size_t K>
+        using leaf_type = typename table_::template leaf_type<K>;
+
+        //! @brief Visit every leaf, i.e. visitor(std::span<leaf_type<K>, leaves[K].count>, std::integral_constant<std::size_t, K>{}).
+        template<typename Visitor>
+        inline static void visit_leaves(T& data, Visitor&& visitor)
+        {
+            table_::visit_(reinterpret_cast<std::byte*>(&data), visitor, std::make_index_sequence<num_leaves>{});
+        }
+
+        //! @brief Visit every leaf, i.e. visitor(std::span<const leaf_type<K>, leaves[K].count>, std::integral_constant<std::size_t, K>{}).
+        template<typename Visitor>
+        inline static void visit_leaves(const T& data, Visitor&& visitor)
+        {
+            table_::visit_(reinterpret_cast<const std::byte*>(&data), visitor, std::make_index_sequence<num_leaves>{});
+        }
+    };
+
+    //! @brief Visit every leaf field of \data, see flatten_traits<T>::visit_leaves.
+    template<aggregate T, typename Visitor>
+    inline void visit_leaves(T& data, Visitor&& visitor)
+    {
+        flatten_traits<T>::visit_leaves(data, visitor);
+    }
+
+    //! @brief Visit every leaf field of \data, see flatten_traits<T>::visit_leaves.
+    template<aggregate T, typename Visitor>
+    inline void visit_leaves(const T& data, Visitor&& visitor)
+    {
+        flatten_traits<T>::visit_leaves(data, visitor);
+    }
+}
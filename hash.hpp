@@ -0,0 +1,217 @@
+//!
+//! @brief   Reflective hash of aggregate types.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! The hash walks the fields through struct_traits and recurses into nested aggregates and arrays:
+//!   1) struct having unique object representation (no padding, no floating point) is hashed in one pass,
+//!   2) otherwise adjacent fields having unique object representation are merged into one byte range,
+//!      floating point (and std::complex) fields are hashed by value (+0.0 and -0.0 have the same hash),
+//!      other fields are hashed by std::hash.
+//! So that objects compared equal by their fields have the same hash.
+//!
+//! layout_fingerprint_v<T> is a compile-time hash of the memory layout of T (not of its values),
+//! used to check that raw records written by another process or build have the same layout.
+//!
+
+#pragma once
+#include <cstddef>  // byte
+#include <cstdint>  // uint64_t
+#include <cstring>  // memcpy
+#include <array>
+#include <complex>
+#include <functional>
+#include <span>
+
+#include "field_segments.hpp"
+
+namespace zhb {
+
+    namespace detail
+    {
+        inline constexpr std::uint64_t hash_k0_ = 0x9E3779B97F4A7C15ull;
+        inline constexpr std::uint64_t hash_k1_ = 0xD6E8FEB86659FD93ull;
+
+        //! @brief final mixing of the hash value.
+        inline constexpr std::uint64_t hash_final_(std::uint64_t h)noexcept
+        {
+            h ^= h >> 32; h *= hash_k1_;
+            h ^= h >> 32; h *= hash_k1_;
+            h ^= h >> 32;
+            return h;
+        }
+
+        //! @brief mix one 8-byte word into the hash value.
+        inline constexpr std::uint64_t hash_word_(std::uint64_t h, std::uint64_t w)noexcept
+        {
+            h = (h ^ w) * hash_k0_;
+            return h ^ (h >> 29);
+        }
+
+        //! @brief load the last \n (< 8) bytes as a word by at most 3 loads,
+        //!        avoid store-to-load forwarding stalls of memcpy to a zeroed word.
+        inline std::uint64_t load_tail_(const std::byte* p, std::size_t n)noexcept
+        {
+            std::uint64_t w = 0;
+            unsigned shift = 0;
+            if (n & 4) { std::uint32_t v; std::memcpy(&v, p, 4); w |= std::uint64_t(v);          p += 4; shift += 32; }
+            if (n & 2) { std::uint16_t v; std::memcpy(&v, p, 2); w |= std::uint64_t(v) << shift; p += 2; shift += 16; }
+            if (n & 1) { w |= std::uint64_t(std::to_integer<std::uint8_t>(*p)) << shift; }
+            return w ^ (std::uint64_t(n) << 56);
+        }
+
+        //! @brief mix \n bytes into the hash value, 8 bytes at a time.
+        inline std::uint64_t hash_bytes_(std::uint64_t h, const std::byte* p, std::size_t n)noexcept
+        {
+            for (; n >= 8; n -= 8, p += 8) {
+                std::uint64_t w;
+                std::memcpy(&w, p, 8);
+                h = hash_word_(h, w);
+            }
+            if (n > 0)h = hash_word_(h, load_tail_(p, n));
+            return h;
+        }
+
+        template<typename U> std::uint64_t hash_value_(std::uint64_t h, const U& value)noexcept;
+
+        template<aggregate T, std::size_t... I>
+        inline std::uint64_t hash_fields_(std::uint64_t h, const T& value, std::index_sequence<I...>)noexcept
+        {
+            constexpr auto& seg = field_segments_<T>::segments;
+            ((h = seg[I].size > 0
+                ? hash_bytes_(h, reinterpret_cast<const std::byte*>(&struct_traits<T>::template get<seg[I].field>(value)), seg[I].size)
+                : hash_value_(h, struct_traits<T>::template get<seg[I].field>(value))), ...);
+            return h;
+        }
+
+        //! @brief mix \value into the hash value.
+        template<typename U>
+        inline std::uint64_t hash_value_(std::uint64_t h, const U& value)noexcept
+        {
+            if constexpr (has_unique_representation_<U>) {
+                return hash_bytes_(h, reinterpret_cast<const std::byte*>(&value), sizeof(U));
+            }
+            else if constexpr (std::is_floating_point_v<U> && sizeof(U) > sizeof(double)) {
+                return hash_value_(h, static_cast<double>(value)); // long double may have padding bytes
+            }
+            else if constexpr (std::is_floating_point_v<U>) {
+                const U v = value == U(0) ? U(0) : value; // -0.0 == +0.0
+                return hash_bytes_(h, reinterpret_cast<const std::byte*>(&v), sizeof(U));
+            }
+            else if constexpr (std::is_array_v<U>) {
+                for (const auto& v : value)h = hash_value_(h, v);
+                return h;
+            }
+            else if constexpr (is_complex_field_<U>::value) {
+                return hash_value_(hash_value_(h, value.real()), value.imag()); // std::hash has no specialization of std::complex
+            }
+            else if constexpr (aggregate<U>) {
+                return hash_fields_(h, value, std::make_index_sequence<field_segments_<U>::segments.size()>{});
+            }
+            else {
+                return hash_word_(h, std::hash<U>{}(value));
+            }
+        }
+
+        //! @brief hash a block of sizeof...(L) records at once in interleaved lanes,
+        //!        gives the same result as hashing them one by one.
+        template<aggregate T, std::size_t... L>
+        inline void hash_lanes_(const T* records, std::uint64_t* out, std::uint64_t seed, std::index_sequence<L...>)noexcept
+        {
+            std::uint64_t h[] = { (static_cast<void>(L), seed)... };
+
+            const auto p = reinterpret_cast<const std::byte*>(records);
+            constexpr std::size_t nword = sizeof(T) / 8, ntail = sizeof(T) % 8;
+            for (std::size_t k = 0; k < nword; ++k) {
+                std::uint64_t w[sizeof...(L)];
+                ((std::memcpy(&w[L], p + L * sizeof(T) + k * 8, 8)), ...);
+                ((h[L] = hash_word_(h[L], w[L])), ...);
+            }
+            if constexpr (ntail > 0)
+                ((h[L] = hash_word_(h[L], load_tail_(p + L * sizeof(T) + nword * 8, ntail))), ...);
+
+            ((out[L] = hash_final_(h[L])), ...);
+        }
+    }
+
+    namespace detail
+    {
+        //! @brief kind of type mixed into the layout fingerprint.
+        enum class layout_kind_ : std::uint64_t { other = 1, boolean, signed_integer, unsigned_integer, floating_point, pointer, enumeration, complex, array, aggregate };
+
+        template<typename U> constexpr std::uint64_t layout_fingerprint_()noexcept;
+
+        template<aggregate T, std::size_t... I>
+        constexpr std::uint64_t layout_fields_(std::uint64_t h, std::index_sequence<I...>)noexcept
+        {
+            ((h = hash_word_(hash_word_(h, offsets_v<T>[I]), layout_fingerprint_<field_type_t<T, I>>())), ...);
+            return h;
+        }
+
+        //! @brief fingerprint of the layout of \U: kind, size and alignment, plus the element type and extent of array,
+        //!        the underlying type of enum, the field number, offsets and fingerprints of nested aggregate.
+        template<typename U>
+        constexpr std::uint64_t layout_fingerprint_()noexcept
+        {
+            using V = std::remove_cv_t<U>;
+            const auto mix = [](layout_kind_ kind) {
+                return hash_word_(hash_word_(hash_word_(hash_k1_, static_cast<std::uint64_t>(kind)), sizeof(V)), alignof(V));
+                };
+
+            if constexpr (std::is_array_v<V>)
+                return hash_word_(hash_word_(mix(layout_kind_::array), std::extent_v<V>), layout_fingerprint_<std::remove_extent_t<V>>());
+            else if constexpr (is_std_array_field_<V>::value)
+                return layout_fingerprint_<typename V::value_type[std::tuple_size_v<V>]>();
+            else if constexpr (is_complex_field_<V>::value)
+                return hash_word_(mix(layout_kind_::complex), layout_fingerprint_<typename V::value_type>());
+            else if constexpr (std::is_enum_v<V>)
+                return hash_word_(mix(layout_kind_::enumeration), layout_fingerprint_<std::underlying_type_t<V>>());
+            else if constexpr (std::is_same_v<V, bool>)
+                return mix(layout_kind_::boolean);
+            else if constexpr (std::is_floating_point_v<V>)
+                return mix(layout_kind_::floating_point);
+            else if constexpr (std::is_integral_v<V>)
+                return mix(std::is_signed_v<V> ? layout_kind_::signed_integer : layout_kind_::unsigned_integer);
+            else if constexpr (std::is_pointer_v<V>)
+                return mix(layout_kind_::pointer);
+            else if constexpr (aggregate<V>)
+                return layout_fields_<V>(hash_word_(mix(layout_kind_::aggregate), num_fields_v<V>), std::make_index_sequence<num_fields_v<V>>{});
+            else
+                return mix(layout_kind_::other);
+        }
+    }
+
+    //! @brief Compile-time fingerprint of the memory layout of \T: sizeof(T), the field number, and the type kind, size,
+    //!        offset and array extents of every field, nested aggregates are included recursively.
+    //!        Field names are not included, two structs having the same layout have the same fingerprint.
+    template<aggregate T> constexpr std::uint64_t layout_fingerprint_v = detail::hash_final_(detail::layout_fingerprint_<T>());
+
+    //! @brief hash function object of aggregate type, can be used by std::unordered_map.
+    template<aggregate T>
+    struct hash
+    {
+        std::uint64_t seed = detail::hash_k1_;
+
+        std::size_t operator()(const T& value)const noexcept
+        {
+            return static_cast<std::size_t>(detail::hash_final_(detail::hash_value_(seed, value)));
+        }
+    };
+
+    //! @brief Hash all the records, out[i] = hash<T>{seed}(records[i]).
+    //! @note  records having unique object representation are hashed 4 at a time in interleaved lanes.
+    template<aggregate T>
+    inline void hash_many(std::span<const T> records, std::uint64_t* out, std::uint64_t seed = detail::hash_k1_)noexcept
+    {
+        std::size_t i = 0;
+        if constexpr (detail::has_unique_representation_<T>) {
+            constexpr std::size_t lanes = 4;
+            for (; i + lanes <= records.size(); i += lanes)
+                detail::hash_lanes_<T>(records.data() + i, out + i, seed, std::make_index_sequence<lanes>{});
+        }
+        const hash<T> h{ seed };
+        for (; i < records.size(); ++i)
+            out[i] = h(records[i]);
+    }
+}
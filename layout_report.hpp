@@ -0,0 +1,68 @@
+//!
+//! @brief   Compile-time report of padding bytes in a struct and its optimal field order.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! Only padding between the fields of \T (and after the last one) is counted,
+//! padding inside nested struct fields is not.
+//!
+
+#pragma once
+#include "struct_traits.hpp"
+
+namespace zhb {
+
+    template<aggregate T>
+    struct layout_report
+    {
+        inline static constexpr std::size_t num_fields = num_fields_v<T>;
+
+        //! @brief memory size of the struct.
+        inline static constexpr std::size_t size = sizeof(T);
+
+        //! @brief sum of memory sizes of all fields.
+        inline static constexpr std::size_t field_bytes = [] {
+            std::size_t n = 0;
+            for (auto s : sizes_v<T>)n += s;
+            return n;
+        }();
+
+        //! @brief total padding bytes.
+        inline static constexpr std::size_t padding_bytes = size - field_bytes;
+
+        //! @brief padding bytes after each field.
+        inline static constexpr std::array<std::size_t, num_fields> padding_after = [] {
+            std::array<std::size_t, num_fields> pad{};
+            for (std::size_t i = 0; i < num_fields; ++i) {
+                const std::size_t next = i + 1 < num_fields ? offsets_v<T>[i + 1] : sizeof(T);
+                pad[i] = next - offsets_v<T>[i] - sizes_v<T>[i];
+            }
+            return pad;
+        }();
+
+        //! @brief field indices sorted by alignment (descending), which needs no padding between fields.
+        inline static constexpr std::array<std::size_t, num_fields> optimal_order = [] {
+            std::array<std::size_t, num_fields> order{};
+            for (std::size_t i = 0; i < num_fields; ++i)order[i] = i;
+            // stable insertion sort, keep the declared order of fields with the same alignment
+            for (std::size_t i = 1; i < num_fields; ++i)
+                for (std::size_t j = i; j > 0 && alignments_v<T>[order[j - 1]] < alignments_v<T>[order[j]]; --j) {
+                    const std::size_t t = order[j];
+                    order[j] = order[j - 1];
+                    order[j - 1] = t;
+                }
+            return order;
+        }();
+
+        //! @brief minimal memory size of the struct if fields are reordered by \optimal_order.
+        inline static constexpr std::size_t min_size = field_bytes == 0 ? size : (field_bytes + alignof(T) - 1) / alignof(T) * alignof(T);
+
+        //! @brief padding bytes which can be saved by reordering fields.
+        inline static constexpr std::size_t wasted_bytes = size - min_size;
+    };
+
+    //! @brief Whether or not total padding bytes of \T is no more than \N.
+    //! @code static_assert(zhb::max_padding_v<A, 8>, "too many padding bytes in A"); @endcode
+    template<aggregate T, std::size_t N> constexpr bool max_padding_v = layout_report<T>::padding_bytes <= N;
+}
@@ -0,0 +1,197 @@
+//!
+//! @brief   Sequence lock of aggregate state: lock-free readers take torn-free copies of the whole struct or of some fields.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//!   zhb::seqlock<A> state;
+//!   state.store(a);                                      // whole struct
+//!   state.store<1, 4>(3.0, 42);                          // fields a1 and a4 in one update
+//!   state.update<1>([](A& a) { zhb::struct_traits<A>::get<1>(a) *= 2; });
+//!
+//!   A snapshot = state.load();                           // all fields
+//!   A partial  = state.read<1, 4>();                     // only a1 and a4 are copied, other fields are value-initialized
+//!
+//! The struct is stored in 8-byte atomic words, readers load only the words of the requested fields and retry
+//! if a writer was running (the sequence is odd or changed). Writers never wait for readers, they are serialized
+//! by the sequence itself, and keep a private copy of the struct so that a field update publishes only its words.
+//!
+
+#pragma once
+#include <atomic>
+#include <cstdint>  // uint64_t
+#include <cstring>  // memcpy
+
+#include "struct_traits.hpp"
+
+namespace zhb {
+
+    namespace detail
+    {
+        //! @brief hint to the CPU in spin loops.
+        inline void spin_pause_()noexcept
+        {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+            __builtin_ia32_pause();
+#endif
+        }
+    }
+
+    template<aggregate T>
+    class seqlock
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "seqlock only supports trivially copyable struct!");
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "lock-free 64-bit atomic is required!");
+
+        using word_type = std::uint64_t;
+
+        inline static constexpr std::size_t word_size = sizeof(word_type);
+        inline static constexpr std::size_t num_words = (sizeof(T) + word_size - 1) / word_size;
+
+    public:
+        seqlock()noexcept : seqlock(T{}) {}
+
+        explicit seqlock(const T& value)noexcept : value_(value)
+        {
+            store_words_(0, sizeof(T));
+        }
+
+        seqlock(const seqlock&) = delete;
+        seqlock& operator = (const seqlock&) = delete;
+
+        //! @brief Take a torn-free copy of the fields \I..., other fields of the result are value-initialized.
+        //!        All fields are copied if \I is empty.
+        template<std::size_t... I>
+        T read()const noexcept
+        {
+            word_type words[num_words];
+            for (;;) {
+                const std::uint64_t seq = seq_.load(std::memory_order_acquire);
+                if (seq & 1) {
+                    detail::spin_pause_(); // a writer is running
+                    continue;
+                }
+                if constexpr (sizeof...(I) == 0)
+                    load_words_(words, 0, sizeof(T));
+                else
+                    (load_words_(words, offsets_v<T>[I], sizes_v<T>[I]), ...);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == seq)break;
+            }
+
+            T value{};
+            const auto src = reinterpret_cast<const std::byte*>(words);
+            const auto dst = reinterpret_cast<std::byte*>(&value);
+            if constexpr (sizeof...(I) == 0)
+                std::memcpy(dst, src, sizeof(T));
+            else
+                (std::memcpy(dst + offsets_v<T>[I], src + offsets_v<T>[I], sizes_v<T>[I]), ...);
+            return value;
+        }
+
+        //! @brief Take a torn-free copy of the whole struct.
+        T load()const noexcept { return read<>(); }
+
+        //! @brief Modify the struct by \f(T&), then publish the fields \I..., or the whole struct if \I is empty.
+        //!        \f is called with the latest value written by the writers, e.g. it may use struct_traits<T>::get<I>.
+        //! @note  \f should only modify the fields \I.... If \f throws, nothing is published and the private copy
+        //!        is restored from the published words, so its partial modifications are not published by later updates.
+        template<std::size_t... I, typename F>
+        void update(F&& f)
+        {
+            const std::uint64_t seq = lock_();
+            struct unlock_guard
+            {
+                std::atomic<std::uint64_t>& seq_;
+                std::uint64_t               value;
+                ~unlock_guard() { seq_.store(value, std::memory_order_release); }
+            } guard{ seq_, seq + 2 };
+
+            try {
+                f(value_);
+            }
+            catch (...) {
+                restore_();
+                throw;
+            }
+            if constexpr (sizeof...(I) == 0)
+                store_words_(0, sizeof(T));
+            else
+                (store_words_(offsets_v<T>[I], sizes_v<T>[I]), ...);
+        }
+
+        //! @brief Store the whole struct.
+        void store(const T& value)noexcept
+        {
+            update([&value](T& v) { v = value; });
+        }
+
+        //! @brief Store the fields \I, \Rest... in one update.
+        template<std::size_t I, std::size_t... Rest>
+        void store(const field_type_t<T, I>& value, const field_type_t<T, Rest>&... rest)noexcept
+        {
+            update<I, Rest...>([&](T& v) {
+                assign_(struct_traits<T>::template get<I>(v), value);
+                (assign_(struct_traits<T>::template get<Rest>(v), rest), ...);
+                });
+        }
+
+    private:
+        template<typename U>
+        static void assign_(U& dst, const U& src)noexcept
+        {
+            if constexpr (std::is_array_v<U>)std::memcpy(&dst, &src, sizeof(U));
+            else dst = src;
+        }
+
+        //! @brief make the sequence odd, wait while another writer is running.
+        std::uint64_t lock_()noexcept
+        {
+            std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+            for (;;) {
+                if (seq & 1) {
+                    detail::spin_pause_();
+                    seq = seq_.load(std::memory_order_relaxed);
+                }
+                else if (seq_.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_release); // the words are not stored before the odd sequence
+            return seq;
+        }
+
+        //! @brief load the words covering the bytes [offset, offset + size).
+        void load_words_(word_type* words, std::size_t offset, std::size_t size)const noexcept
+        {
+            for (std::size_t k = offset / word_size, last = (offset + size + word_size - 1) / word_size; k < last; ++k)
+                words[k] = words_[k].load(std::memory_order_relaxed);
+        }
+
+        //! @brief restore the private copy from the published words, called by a writer.
+        void restore_()noexcept
+        {
+            word_type words[num_words];
+            load_words_(words, 0, sizeof(T));
+            std::memcpy(&value_, words, sizeof(T));
+        }
+
+        //! @brief store the words covering the bytes [offset, offset + size) from the private copy.
+        void store_words_(std::size_t offset, std::size_t size)noexcept
+        {
+            const auto src = reinterpret_cast<const std::byte*>(&value_);
+            for (std::size_t k = offset / word_size, last = (offset + size + word_size - 1) / word_size; k < last; ++k) {
+                word_type w = 0;
+                const std::size_t n = k + 1 < num_words ? word_size : sizeof(T) - k * word_size;
+                std::memcpy(&w, src + k * word_size, n);
+                words_[k].store(w, std::memory_order_relaxed);
+            }
+        }
+
+        alignas(64) std::atomic<std::uint64_t> seq_{ 0 };   //!< odd while a writer is running
+        std::atomic<word_type> words_[num_words];         //!< the published struct, read by readers
+
+        alignas(64) T value_;                              //!< private copy of the writers, on its own cache line
+    };
+}
@@ -0,0 +1,254 @@
+//!
+//! @brief   Lock-free single-producer single-consumer ring of aggregate records in POSIX shared memory.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! The producer and the consumer may live in different processes:
+//!
+//!   auto ring = zhb::shm_ring<A>::create("/ingest", 1 << 16);  // producer
+//!   auto ring = zhb::shm_ring<A>::attach("/ingest");           // consumer, the layout of A is checked
+//!
+//!   std::size_t n = ring.publish(records);   // copy at most records.size() records in, return the number copied
+//!   std::size_t m = ring.consume(buffer);    // copy at most buffer.size() records out
+//!
+//! Memory layout:
+//!
+//!   | header | head (consumer index) | tail (producer index) | records[capacity] |
+//!
+//! head and tail are on different cache lines, each side also caches the index of the other side,
+//! so that the shared cache line is only read when the ring looks full (producer) or empty (consumer).
+//! A batch is copied by at most two memcpy and published by one release store.
+//!
+//! POSIX only (shm_open/mmap).
+//!
+
+#pragma once
+#include <algorithm> // min
+#include <atomic>
+#include <bit>       // bit_ceil, bit_floor
+#include <cerrno>
+#include <cstdint>   // uint64_t, SIZE_MAX
+#include <cstring>   // memcpy
+#include <span>
+#include <stdexcept> // length_error
+#include <system_error>
+#include <utility>  // exchange, swap
+
+#include <fcntl.h>     // O_CREAT
+#include <sys/mman.h>  // shm_open, mmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close, ftruncate
+
+#include "hash.hpp"
+
+namespace zhb {
+
+    namespace detail
+    {
+        inline constexpr std::size_t cache_line_size_ = 64;
+
+        inline constexpr std::uint64_t shm_ring_magic_   = 0x474E4952'4D485348ull; // "SHMRING" + version
+        inline constexpr std::uint32_t shm_ring_version_ = 1;
+
+        //! @brief header at the beginning of the shared memory of the ring.
+        struct shm_ring_header_
+        {
+            alignas(cache_line_size_) std::atomic<std::uint64_t> magic;  //!< stored last by the creator
+            std::uint32_t version;
+            std::uint32_t record_size;
+            std::uint64_t fingerprint;                                    //!< layout_fingerprint_v<T>
+            std::uint64_t capacity;                                       //!< power of 2
+
+            alignas(cache_line_size_) std::atomic<std::uint64_t> head;   //!< next record to consume, written by the consumer
+            alignas(cache_line_size_) std::atomic<std::uint64_t> tail;   //!< next record to publish, written by the producer
+        };
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "lock-free 64-bit atomic is required in shared memory!");
+        static_assert(sizeof(shm_ring_header_) % cache_line_size_ == 0);
+    }
+
+    template<aggregate T>
+    class shm_ring
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "shm_ring only supports trivially copyable struct!");
+
+        using header_type = detail::shm_ring_header_;
+
+    public:
+        //! @brief largest capacity whose shared memory size fits in size_t, a power of 2.
+        inline static constexpr std::size_t max_capacity = std::bit_floor((SIZE_MAX - sizeof(header_type)) / sizeof(T));
+
+        shm_ring() = default;
+
+        shm_ring(const shm_ring&) = delete;
+        shm_ring& operator = (const shm_ring&) = delete;
+
+        shm_ring(shm_ring&& other)noexcept { swap(other); }
+
+        shm_ring& operator = (shm_ring&& other)noexcept
+        {
+            shm_ring(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        ~shm_ring() { unmap_(); }
+
+        //! @brief Create the shared memory \name of at least \capacity records, capacity is rounded up to power of 2.
+        //! @throw std::length_error if \capacity is greater than max_capacity.
+        //! @throw std::system_error if the shared memory exists or can NOT be created.
+        static shm_ring create(const char* name, std::size_t capacity)
+        {
+            if (capacity > max_capacity)throw std::length_error("shm_ring::create: capacity is too large");
+            capacity = std::bit_ceil(capacity < 1 ? 1 : capacity); // <= max_capacity, no overflow
+            const int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd < 0)throw std::system_error(errno, std::generic_category(), "shm_ring::create: shm_open");
+
+            shm_ring ring;
+            ring.size_ = sizeof(header_type) + capacity * sizeof(T);
+            if (::ftruncate(fd, static_cast<off_t>(ring.size_)) != 0) {
+                const int err = errno;
+                ::close(fd);
+                ::shm_unlink(name);
+                throw std::system_error(err, std::generic_category(), "shm_ring::create: ftruncate");
+            }
+            try {
+                ring.map_(fd, "shm_ring::create: mmap");
+            }
+            catch (...) {
+                ::shm_unlink(name); // the name is not left behind, create() may be retried
+                throw;
+            }
+
+            // the memory is zero-filled by ftruncate, head and tail are 0
+            header_type& h = *ring.header_;
+            h.version     = detail::shm_ring_version_;
+            h.record_size = static_cast<std::uint32_t>(sizeof(T));
+            h.fingerprint = layout_fingerprint_v<T>;
+            h.capacity    = capacity;
+            h.magic.store(detail::shm_ring_magic_, std::memory_order_release);
+
+            ring.mask_ = capacity - 1;
+            return ring;
+        }
+
+        //! @brief Attach to the shared memory \name created by create(), the layout of \T is checked.
+        //! @throw std::system_error if the shared memory can NOT be mapped, is not yet initialized or the layout is different.
+        static shm_ring attach(const char* name)
+        {
+            const int fd = ::shm_open(name, O_RDWR, 0);
+            if (fd < 0)throw std::system_error(errno, std::generic_category(), "shm_ring::attach: shm_open");
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(header_type)) {
+                const int err = errno;
+                ::close(fd);
+                throw std::system_error(err != 0 ? err : EAGAIN, std::generic_category(), "shm_ring::attach: fstat");
+            }
+
+            shm_ring ring;
+            ring.size_ = static_cast<std::size_t>(st.st_size);
+            ring.map_(fd, "shm_ring::attach: mmap");
+
+            const header_type& h = *ring.header_;
+            if (h.magic.load(std::memory_order_acquire) != detail::shm_ring_magic_)
+                throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again), "shm_ring::attach: not initialized");
+            if (h.version != detail::shm_ring_version_ || h.record_size != sizeof(T) || h.fingerprint != layout_fingerprint_v<T> ||
+                !std::has_single_bit(h.capacity) || h.capacity > max_capacity || ring.size_ < sizeof(header_type) + h.capacity * sizeof(T))
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument), "shm_ring::attach: layout mismatch");
+
+            ring.mask_       = h.capacity - 1;
+            ring.head_cache_ = h.head.load(std::memory_order_acquire);
+            ring.tail_cache_ = h.tail.load(std::memory_order_acquire);
+            return ring;
+        }
+
+        //! @brief Remove the shared memory \name, the mapped rings are still valid.
+        static void unlink(const char* name)noexcept { ::shm_unlink(name); }
+
+        //! @brief Copy records into the ring, called by the producer only.
+        //! @return number of records copied, less than records.size() if the ring is full.
+        std::size_t publish(std::span<const T> records)noexcept
+        {
+            const std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+            std::size_t n = free_(tail);
+            if (n < records.size()) {
+                head_cache_ = header_->head.load(std::memory_order_acquire);
+                n = free_(tail);
+            }
+            n = std::min(n, records.size());
+            if (n == 0)return 0;
+
+            const std::size_t pos = tail & mask_, first = std::min(n, capacity() - pos);
+            std::memcpy(records_() + pos, records.data(), first * sizeof(T));
+            std::memcpy(records_(), records.data() + first, (n - first) * sizeof(T)); // wrapped part
+            header_->tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        //! @brief Copy records out of the ring, called by the consumer only.
+        //! @return number of records copied, less than records.size() if the ring is empty.
+        std::size_t consume(std::span<T> records)noexcept
+        {
+            const std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+            std::size_t n = static_cast<std::size_t>(tail_cache_ - head);
+            if (n < records.size()) {
+                tail_cache_ = header_->tail.load(std::memory_order_acquire);
+                n = static_cast<std::size_t>(tail_cache_ - head);
+            }
+            n = std::min(n, records.size());
+            if (n == 0)return 0;
+
+            const std::size_t pos = head & mask_, first = std::min(n, capacity() - pos);
+            std::memcpy(records.data(), records_() + pos, first * sizeof(T));
+            std::memcpy(records.data() + first, records_(), (n - first) * sizeof(T)); // wrapped part
+            header_->head.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        //! @brief maximum number of records in the ring.
+        std::size_t capacity()const noexcept { return mask_ + 1; }
+
+        //! @brief number of records in the ring, exact only if neither side is running.
+        std::size_t size()const noexcept
+        {
+            return static_cast<std::size_t>(header_->tail.load(std::memory_order_acquire) - header_->head.load(std::memory_order_acquire));
+        }
+
+        void swap(shm_ring& other)noexcept
+        {
+            std::swap(header_, other.header_);
+            std::swap(size_, other.size_);
+            std::swap(mask_, other.mask_);
+            std::swap(head_cache_, other.head_cache_);
+            std::swap(tail_cache_, other.tail_cache_);
+        }
+
+    private:
+        T* records_()const noexcept { return reinterpret_cast<T*>(header_ + 1); }
+
+        //! @brief number of free slots seen by the producer.
+        std::size_t free_(std::uint64_t tail)const noexcept { return capacity() - static_cast<std::size_t>(tail - head_cache_); }
+
+        void map_(int fd, const char* what)
+        {
+            void* p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            const int err = errno;
+            ::close(fd); // the mapping is kept after closing
+            if (p == MAP_FAILED)throw std::system_error(err, std::generic_category(), what);
+            header_ = static_cast<header_type*>(p);
+        }
+
+        void unmap_()noexcept
+        {
+            if (header_ != nullptr)::munmap(std::exchange(header_, nullptr), size_);
+        }
+
+        header_type*  header_ = nullptr;
+        std::size_t   size_   = 0;
+        std::size_t   mask_   = 0;
+
+        std::uint64_t head_cache_ = 0; //!< head seen by the producer
+        std::uint64_t tail_cache_ = 0; //!< tail seen by the consumer
+    };
+}
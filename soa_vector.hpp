@@ -0,0 +1,277 @@
+//!
+//! @brief   Struct-of-arrays container generated from struct_traits.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! Every field of the struct is stored in its own contiguous and aligned column,
+//! all columns share ONE allocation:
+//!
+//!   |<- column 0 ->|pad|<- column 1 ->|pad| ... |<- column N-1 ->|
+//!
+
+#pragma once
+#include <cstddef>  // byte
+#include <cstring>  // memcpy
+#include <limits>
+#include <new>      // align_val_t
+#include <span>
+#include <stdexcept> // length_error
+#include <utility>  // swap
+
+#include "struct_traits.hpp"
+
+namespace zhb {
+
+    template<aggregate T>
+    class soa_vector
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "soa_vector only supports trivially copyable struct!");
+
+        template<bool Const> class basic_reference_;
+
+    public:
+        using value_type      = T;
+        using size_type       = std::size_t;
+        using reference       = basic_reference_<false>;
+        using const_reference = basic_reference_<true>;
+
+        //! @brief type of the I-th column.
+        template<std::size_t I>
+        using column_type = field_type_t<T, I>;
+
+        //! @brief number of columns.
+        inline static constexpr std::size_t num_fields = num_fields_v<T>;
+
+        //! @brief alignment in bytes of every column, at least one cache line (or alignof the field if larger).
+        inline static constexpr std::size_t column_alignment = 64;
+
+        soa_vector() = default;
+
+        explicit soa_vector(size_type n) { resize(n); }
+
+        soa_vector(const soa_vector& other)
+        {
+            reserve(other.size_);
+            copy_columns_(other.data_, other.offsets_, other.size_);
+            size_ = other.size_;
+        }
+
+        soa_vector(soa_vector&& other)noexcept { swap(other); }
+
+        ~soa_vector() { deallocate_(data_); }
+
+        soa_vector& operator = (const soa_vector& other)
+        {
+            if (this != &other) {
+                soa_vector tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        soa_vector& operator = (soa_vector&& other)noexcept
+        {
+            soa_vector tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        void swap(soa_vector& other)noexcept
+        {
+            std::swap(data_,     other.data_);
+            std::swap(size_,     other.size_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(offsets_,  other.offsets_);
+        }
+
+        size_type size    ()const noexcept { return size_; }
+        size_type capacity()const noexcept { return capacity_; }
+        bool      empty   ()const noexcept { return size_ == 0; }
+
+        //! @brief remove all records, the capacity is unchanged.
+        void clear()noexcept { size_ = 0; }
+
+        //! @brief grow all the columns in one allocation.
+        //! @throw std::length_error if the allocation of \n records would overflow std::size_t.
+        void reserve(size_type n)
+        {
+            if (n > capacity_)reallocate_(n);
+        }
+
+        //! @brief resize all the columns, new records are value-initialized.
+        void resize(size_type n)
+        {
+            reserve(n);
+            if (n > size_) {
+                const T value{};
+                for (size_type i = size_; i < n; ++i)
+                    set_(i, value);
+            }
+            size_ = n;
+        }
+
+        //! @brief resize all the columns, new records are NOT initialized and should be overwritten, e.g. by aos_to_soa.
+        void resize_for_overwrite(size_type n)
+        {
+            reserve(n);
+            size_ = n;
+        }
+
+        //! @brief append a record, every field is copied into its column.
+        void push_back(const T& value)
+        {
+            if (size_ == capacity_)
+                reallocate_(capacity_ == 0 ? 1 : capacity_ * 2);
+            set_(size_, value);
+            ++size_;
+        }
+
+        void pop_back()noexcept { --size_; }
+
+        //! @brief Get a struct-like proxy of the i-th record.
+        reference       operator[](size_type i)noexcept      { return reference(this, i); }
+        //! @brief Get a struct-like proxy of the i-th record.
+        const_reference operator[](size_type i)const noexcept { return const_reference(this, i); }
+
+        //! @brief Get the I-th column.
+        template<std::size_t I>
+        std::span<column_type<I>> column()noexcept
+        {
+            return { column_data_<I>(data_, offsets_), size_ };
+        }
+
+        //! @brief Get the I-th column.
+        template<std::size_t I>
+        std::span<const column_type<I>> column()const noexcept
+        {
+            return { column_data_<I>(data_, offsets_), size_ };
+        }
+
+    private:
+        using offsets_type = std::array<std::size_t, num_fields>;
+
+        std::byte*   data_     = nullptr;
+        size_type    size_     = 0;
+        size_type    capacity_ = 0;
+        offsets_type offsets_{};
+
+        //! @brief alignment of the I-th column.
+        static constexpr std::size_t column_alignment_(std::size_t i)noexcept
+        {
+            return alignments_v<T>[i] > column_alignment ? alignments_v<T>[i] : column_alignment;
+        }
+
+        //! @brief alignment of the allocation, i.e. the largest alignment of the columns.
+        inline static constexpr std::size_t storage_alignment_ = [] {
+            std::size_t align = column_alignment;
+            for (std::size_t i = 0; i < num_fields; ++i)
+                if (column_alignment_(i) > align)align = column_alignment_(i);
+            return align;
+        }();
+
+        //! @brief compute offsets of all the columns for \capacity records.
+        //! @return total bytes of the allocation.
+        //! @throw std::length_error if the size of the allocation overflows.
+        static std::size_t layout_(size_type capacity, offsets_type& offsets)
+        {
+            constexpr std::size_t max_size = std::numeric_limits<std::size_t>::max();
+            std::size_t pos = 0;
+            for (std::size_t i = 0; i < num_fields; ++i) {
+                const std::size_t align = column_alignment_(i);
+                if (pos > max_size - (align - 1))throw std::length_error("soa_vector: too many records");
+                pos = (pos + align - 1) / align * align;
+                offsets[i] = pos;
+                if (capacity > (max_size - pos) / sizes_v<T>[i])throw std::length_error("soa_vector: too many records");
+                pos += sizes_v<T>[i] * capacity;
+            }
+            return pos;
+        }
+
+        template<std::size_t I>
+        static column_type<I>* column_data_(std::byte* data, const offsets_type& offsets)noexcept
+        {
+            return reinterpret_cast<column_type<I>*>(data + offsets[I]);
+        }
+
+        static void deallocate_(std::byte* data)noexcept
+        {
+            if (data)::operator delete(data, std::align_val_t{ storage_alignment_ });
+        }
+
+        void reallocate_(size_type capacity)
+        {
+            offsets_type offsets{};
+            const std::size_t nbytes = layout_(capacity, offsets);
+            auto data = static_cast<std::byte*>(::operator new(nbytes == 0 ? 1 : nbytes, std::align_val_t{ storage_alignment_ }));
+
+            for (std::size_t i = 0; i < num_fields; ++i)
+                if (size_ > 0)std::memcpy(data + offsets[i], data_ + offsets_[i], sizes_v<T>[i] * size_);
+
+            deallocate_(data_);
+            data_     = data;
+            offsets_  = offsets;
+            capacity_ = capacity;
+        }
+
+        void copy_columns_(std::byte* data, const offsets_type& offsets, size_type n)noexcept
+        {
+            for (std::size_t i = 0; i < num_fields; ++i)
+                if (n > 0)std::memcpy(data_ + offsets_[i], data + offsets[i], sizes_v<T>[i] * n);
+        }
+
+        void set_(size_type i, const T& value)noexcept
+        {
+            struct_traits<T>::visit_indexed(value, [this, i](auto& val, auto I) {
+                std::memcpy(column_data_<I>(data_, offsets_) + i, &val, sizeof(val));
+                });
+        }
+
+        void get_(size_type i, T& value)const noexcept
+        {
+            struct_traits<T>::visit_indexed(value, [this, i](auto& val, auto I) {
+                std::memcpy(&val, column_data_<I>(data_, offsets_) + i, sizeof(val));
+                });
+        }
+    };
+
+    //! @brief struct-like proxy of a record in soa_vector.
+    template<aggregate T>
+    template<bool Const>
+    class soa_vector<T>::basic_reference_
+    {
+        friend class soa_vector<T>;
+        using owner_type = std::conditional_t<Const, const soa_vector<T>, soa_vector<T>>;
+
+        owner_type* owner_;
+        size_type   index_;
+
+        basic_reference_(owner_type* owner, size_type index)noexcept :owner_(owner), index_(index) {}
+
+    public:
+        //! @brief Get reference of the I-th field of this record.
+        template<std::size_t I>
+        auto& get()const noexcept { return owner_->template column<I>()[index_]; }
+
+        //! @brief Get a copy of this record.
+        operator T()const noexcept
+        {
+            T value;
+            owner_->get_(index_, value);
+            return value;
+        }
+
+        //! @brief Overwrite all fields of this record.
+        const basic_reference_& operator = (const T& value)const noexcept requires (!Const)
+        {
+            owner_->set_(index_, value);
+            return *this;
+        }
+
+        //! @brief Copy all fields from another record.
+        const basic_reference_& operator = (const basic_reference_& other)const noexcept requires (!Const)
+        {
+            return *this = static_cast<T>(other);
+        }
+    };
+}
@@ -8,11 +8,19 @@
 //! improvements:
 //!   1) fix bugs if field is array of user defined type.
 //!   2) easy and fast!
+//!   3) support struct with up to 256 fields (see tools/gen_bindings.py).
 //!
 
 #pragma once
 #include <type_traits>
 #include <utility>    // index_sequence
+#include <array>
+#include <bit>        // bit_cast
+#include <cassert>
+#include <complex>
+#include <memory>     // addressof
+
+#include "struct_traits_bindings.hpp"
 
 namespace zhb {
 
@@ -25,7 +33,13 @@ namespace zhb {
         template <typename T, typename... Args>
         concept aggregate_initializable = aggregate<T> && requires { T{ {std::declval<Args>()}... }; };
 
-        struct any { template <typename T> constexpr operator T() const noexcept; };
+        //! @brief target type of any: conversion to class implicitly constructible from arithmetic type (e.g. std::complex)
+        //!        and to builtin non-scalar type (e.g. _Complex) is disabled, otherwise both the converting and the
+        //!        copy constructor of the field are viable and {any} is ambiguous.
+        template <typename T>
+        concept any_target = (std::is_scalar_v<T> || std::is_class_v<T> || std::is_union_v<T>) && !(std::is_class_v<T> && std::is_convertible_v<double, T>);
+
+        struct any { template <any_target T> constexpr operator T() const noexcept; };
 
         template <std::size_t I> using indexed_any = any;
 
@@ -38,16 +52,39 @@ namespace zhb {
         template <typename T, std::size_t N>
         concept aggregate_initializable_with_n_args = aggregate<T> && aggregate_initializable_from_indices<T, std::make_index_sequence<N>>::value;
 
+        //! @brief find an upper bound of the field number by doubling the arity.
+        //! @return the first power of 2 which can NOT be used to initialize \T.
+        template<aggregate T, std::size_t N = 1>
+        inline static consteval std::size_t num_fields_upper_()noexcept
+        {
+            if constexpr (!aggregate_initializable_with_n_args<T, N>)
+                return N;
+            else
+                return num_fields_upper_<T, N * 2>();
+        }
+
+        //! @brief binary search of the field number in range [Lo, Hi).
+        //! @note \T is initializable with \Lo arguments but not with \Hi arguments.
+        template<aggregate T, std::size_t Lo, std::size_t Hi>
+        inline static consteval std::size_t num_fields_search_()noexcept
+        {
+            if constexpr (Hi - Lo <= 1)
+                return Lo;
+            else if constexpr (aggregate_initializable_with_n_args<T, (Lo + Hi) / 2>)
+                return num_fields_search_<T, (Lo + Hi) / 2, Hi>();
+            else
+                return num_fields_search_<T, Lo, (Lo + Hi) / 2>();
+        }
+
         //! @brief get number of total fields
-        //! @tparam T         aggregate data type.
-        //! @tparam NumField  index used for counting fields, should be ZERO.
-        template<aggregate T, std::size_t NumField = 0>
+        //! @note  the arity is probed by exponential and then binary search,
+        //!        so only O(log(N)) initialization checks are instantiated.
+        //! @tparam T  aggregate data type.
+        template<aggregate T>
         inline static consteval std::size_t num_fields_()noexcept
         {
-            if constexpr (!aggregate_initializable_with_n_args<T, NumField + 1>)
-                return NumField;
-            else
-                return num_fields_<T, NumField + 1>();
+            constexpr std::size_t hi = num_fields_upper_<T>();
+            return num_fields_search_<T, hi / 2, hi>();
         }
 
         template<typename T> struct type_
@@ -58,280 +95,293 @@ namespace zhb {
             
             template<std::size_t I = 0>
             static constexpr std::size_t extent = std::extent_v<T, I>;
+        };
+
+        //! @brief argument ignored when selecting the I-th element of a pack.
+        template<std::size_t I>
+        struct ignore_
+        {
+            constexpr ignore_(const volatile void*)noexcept {}
+        };
 
-            type_(const T&) {}
+        template<typename Indices> struct nth_;
+
+        //! @brief select the I-th pointer of a pack in O(1) instantiations, I = sizeof...(Indices).
+        template<std::size_t... Indices>
+        struct nth_<std::index_sequence<Indices...>>
+        {
+            template<typename U, typename... Rest>
+            static constexpr U* get(ignore_<Indices>..., U* p, Rest*...)noexcept { return p; }
         };
 
+        //! @brief get the I-th element of the pack \args.
+        template<std::size_t I, typename... Args>
+        inline constexpr auto& get_nth_(Args&... args)noexcept
+        {
+            return *nth_<std::make_index_sequence<I>>::get(std::addressof(args)...);
+        }
+
         template<aggregate T, std::size_t Field>
-        inline static auto get_field_type_()
+        inline constexpr auto& get_field_value_(T& data)noexcept
         {
             constexpr std::size_t nf = num_fields_<T>();
             static_assert(Field >= 0 && Field < nf);
-            static_assert(nf <= 12, "field number is more than 12 and need to implement!");
 
-            if      constexpr (nf == 1) {
-                auto [a0] = T{};
-                return type_(a0);
-            }
-            else if constexpr (nf == 2) {
-                auto [a0, a1] = T{};
-                if constexpr (Field == 0)return type_(a0);
-                else                     return type_(a1);
-            }
-            else if constexpr (nf == 3) {
-                auto [a0, a1, a2] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else                          return type_(a2);
-            }
-            else if constexpr (nf == 4) {
-                auto [a0, a1, a2, a3] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else                          return type_(a3);
-            }
-            else if constexpr (nf == 5) {
-                auto [a0, a1, a2, a3, a4] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else                          return type_(a4);
-            }
-            else if constexpr (nf == 6) {
-                auto [a0, a1, a2, a3, a4, a5] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else if constexpr (Field == 4)return type_(a4);
-                else                          return type_(a5);
-            }
-            else if constexpr (nf == 7) {
-                auto [a0, a1, a2, a3, a4, a5, a6] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else if constexpr (Field == 4)return type_(a4);
-                else if constexpr (Field == 5)return type_(a5);
-                else                          return type_(a6);
-            }
-            else if constexpr (nf == 8) {
-                auto [a0, a1, a2, a3, a4, a5, a6, a7] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else if constexpr (Field == 4)return type_(a4);
-                else if constexpr (Field == 5)return type_(a5);
-                else if constexpr (Field == 6)return type_(a6);
-                else                          return type_(a7);
-            }
-            else if constexpr (nf == 9) {
-                auto [a0, a1, a2, a3, a4, a5, a6, a7, a8] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else if constexpr (Field == 4)return type_(a4);
-                else if constexpr (Field == 5)return type_(a5);
-                else if constexpr (Field == 6)return type_(a6);
-                else if constexpr (Field == 7)return type_(a7);
-                else                          return type_(a8);
-            }
-            else if constexpr (nf == 10) {
-                auto [a0, a1, a2, a3, a4, a5, a6, a7, a8, a9] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else if constexpr (Field == 4)return type_(a4);
-                else if constexpr (Field == 5)return type_(a5);
-                else if constexpr (Field == 6)return type_(a6);
-                else if constexpr (Field == 7)return type_(a7);
-                else if constexpr (Field == 8)return type_(a8);
-                else                          return type_(a9);
-            }
-            else if constexpr (nf == 11) {
-                auto [a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else if constexpr (Field == 4)return type_(a4);
-                else if constexpr (Field == 5)return type_(a5);
-                else if constexpr (Field == 6)return type_(a6);
-                else if constexpr (Field == 7)return type_(a7);
-                else if constexpr (Field == 8)return type_(a8);
-                else if constexpr (Field == 9)return type_(a9);
-                else                          return type_(a10);
-            }
-            else if constexpr (nf == 12) {
-                auto [a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11] = T{};
-                if      constexpr (Field == 0)return type_(a0);
-                else if constexpr (Field == 1)return type_(a1);
-                else if constexpr (Field == 2)return type_(a2);
-                else if constexpr (Field == 3)return type_(a3);
-                else if constexpr (Field == 4)return type_(a4);
-                else if constexpr (Field == 5)return type_(a5);
-                else if constexpr (Field == 6)return type_(a6);
-                else if constexpr (Field == 7)return type_(a7);
-                else if constexpr (Field == 8)return type_(a8);
-                else if constexpr (Field == 9)return type_(a9);
-                else if constexpr (Field == 10)return type_(a10);
-                else                           return type_(a11);
-            }
+            return bind_fields_<nf>(data, [](auto&... a) -> auto& { return get_nth_<Field>(a...); });
         }
 
+        //! @brief get type of the field, only used in unevaluated context.
+        //! @note  no instance of \T is created, so \T is not required to be constexpr default constructible.
         template<aggregate T, std::size_t Field>
-        inline static auto& get_field_value_(T& data)
+        auto get_field_type_() -> type_<std::remove_reference_t<decltype(get_field_value_<T, Field>(std::declval<T&>()))>>;
+
+        //! @brief call visitor(field) for every field in a single fold expression.
+        template<aggregate T, typename Visitor>
+        inline constexpr void visit_(T& data, Visitor& visitor)
         {
-            constexpr std::size_t nf = num_fields_<T>();
-            static_assert(Field >= 0 && Field < nf);
-            static_assert(nf <= 12, "field number is more than 12 and need to implement!");
+            bind_fields_<num_fields_<T>()>(data, [&visitor](auto&... a) { (visitor(a), ...); });
+        }
+
+        //! @brief call visitor(field, std::integral_constant<std::size_t, I>) for every field.
+        template<aggregate T, typename Visitor, std::size_t... I>
+        inline constexpr void visit_indexed_(T& data, Visitor& visitor, std::index_sequence<I...>)
+        {
+            bind_fields_<sizeof...(I)>(data, [&visitor](auto&... a) {
+                (visitor(a, std::integral_constant<std::size_t, I>{}), ...);
+                });
+        }
+
+        //! @brief same as visit_indexed_ but stop once the visitor returns false.
+        //! @return true if all fields are visited.
+        template<aggregate T, typename Visitor, std::size_t... I>
+        inline constexpr bool visit_indexed_while_(T& data, Visitor& visitor, std::index_sequence<I...>)
+        {
+            return bind_fields_<sizeof...(I)>(data, [&visitor](auto&... a) {
+                return (static_cast<bool>(visitor(a, std::integral_constant<std::size_t, I>{})) && ...);
+                });
+        }
+
+        //! @brief constexpr table of functions calling visitor(field), one entry per field.
+        template<aggregate T, typename Visitor, typename Indices> struct visit_at_table_;
+
+        template<aggregate T, typename Visitor, std::size_t... I>
+        struct visit_at_table_<T, Visitor, std::index_sequence<I...>>
+        {
+            static_assert(sizeof...(I) > 0, "no field to visit!");
+
+            using result_type = decltype(std::declval<Visitor&>()(get_field_value_<T, 0>(std::declval<T&>())));
+            static_assert((std::is_same_v<result_type, decltype(std::declval<Visitor&>()(get_field_value_<T, I>(std::declval<T&>())))> && ...),
+                "visitor should return the same type for all fields!");
+
+            template<std::size_t Field>
+            inline static constexpr result_type call_(T& data, Visitor& visitor) { return visitor(get_field_value_<T, Field>(data)); }
+
+            using function_type = result_type(*)(T&, Visitor&);
+            inline static constexpr function_type table[] = { &call_<I>... };
+        };
+
+        //! @brief call visitor(field) for the field selected by a runtime index.
+        //! @note  dispatched by one indirect call through a constexpr table of function pointers.
+        template<aggregate T, typename Visitor>
+        inline constexpr decltype(auto) visit_at_(T& data, std::size_t index, Visitor& visitor)
+        {
+            return visit_at_table_<T, Visitor, std::make_index_sequence<num_fields_<T>()>>::table[index](data, visitor);
+        }
+
+        template<aggregate T, std::size_t I>
+        using field_type_ = typename decltype(get_field_type_<T, I>())::type;
 
-            if      constexpr (nf == 1) {
-                auto& [a0] = data;
-                return a0;
+        template<aggregate T, typename Indices = std::make_index_sequence<num_fields_<T>()>>
+        struct field_layout_;
+
+        template<typename U> struct is_complex_field_ : std::false_type {};
+        template<typename U> struct is_complex_field_<std::complex<U>> : std::true_type {};
+
+        template<typename U> struct is_std_array_field_ : std::false_type {};
+        template<typename U, std::size_t N> struct is_std_array_field_<std::array<U, N>> : std::true_type {};
+
+        //! @brief whether or not the layout of \U can be probed at compiling time, i.e. \U is made of arithmetic
+        //!        (except long double, which has padding bytes), enum, std::complex, arrays and aggregates of them,
+        //!        so that a constexpr instance can be std::bit_cast to bytes.
+        template<typename U>
+        consteval bool layout_probeable_()noexcept
+        {
+            if constexpr (std::is_array_v<U>)
+                return layout_probeable_<std::remove_extent_t<U>>();
+            else if constexpr (is_std_array_field_<U>::value)
+                return layout_probeable_<typename U::value_type>();
+            else if constexpr (is_complex_field_<U>::value)
+                return layout_probeable_<typename U::value_type>();
+            else if constexpr (std::is_same_v<std::remove_cv_t<U>, long double>)
+                return false;
+            else if constexpr (std::is_arithmetic_v<U> || std::is_enum_v<U>)
+                return !std::is_const_v<U> && !std::is_volatile_v<U>;
+            else if constexpr (aggregate<U> && !std::is_union_v<U> && !std::is_const_v<U> && !std::is_volatile_v<U>)
+                return[]<std::size_t... I>(std::index_sequence<I...>) {
+                    return (layout_probeable_<field_type_<U, I>>() && ...);
+                }(std::make_index_sequence<num_fields_<U>()>{});
+            else
+                return false;
+        }
+
+        //! @brief marker byte of the k-th leaf field, 0 and 1 (bool) are not used.
+        inline constexpr unsigned char layout_marker_(std::size_t k)noexcept { return static_cast<unsigned char>(k % 254 + 2); }
+
+        //! @brief set every byte of the k-th leaf field of \v to its marker, only the first element of an array is set.
+        template<typename U>
+        constexpr void layout_fill_(U& v, std::size_t& k)noexcept
+        {
+            if constexpr (std::is_array_v<U> || is_std_array_field_<U>::value) {
+                layout_fill_(v[0], k); // the offsets of other elements follow from the first one
             }
-            else if constexpr (nf == 2) {
-                auto& [a0, a1] = data;
-                if constexpr (Field == 0)return a0;
-                else                     return a1;
+            else if constexpr (is_complex_field_<U>::value) {
+                typename U::value_type re{}, im{};
+                layout_fill_(re, k);
+                layout_fill_(im, k);
+                v = U(re, im);
             }
-            else if constexpr (nf == 3) {
-                auto& [a0, a1, a2] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else                          return a2;
+            else if constexpr (std::is_same_v<U, bool>) {
+                v = true;
+                ++k;
             }
-            else if constexpr (nf == 4) {
-                auto& [a0, a1, a2, a3] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else                          return a3;
+            else if constexpr (std::is_enum_v<U>) {
+                std::underlying_type_t<U> u{};
+                layout_fill_(u, k);
+                v = static_cast<U>(u);
             }
-            else if constexpr (nf == 5) {
-                auto& [a0, a1, a2, a3, a4] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else                          return a4;
+            else if constexpr (std::is_arithmetic_v<U>) {
+                std::array<unsigned char, sizeof(U)> bytes{};
+                bytes.fill(layout_marker_(k++));
+                v = std::bit_cast<U>(bytes);
             }
-            else if constexpr (nf == 6) {
-                auto& [a0, a1, a2, a3, a4, a5] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else if constexpr (Field == 4)return a4;
-                else                          return a5;
+            else {
+                bind_fields_<num_fields_<U>()>(v, [&k](auto&... a) { (layout_fill_(a, k), ...); });
             }
-            else if constexpr (nf == 7) {
-                auto& [a0, a1, a2, a3, a4, a5, a6] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else if constexpr (Field == 4)return a4;
-                else if constexpr (Field == 5)return a5;
-                else                          return a6;
+        }
+
+        //! @brief check that the bytes of the k-th leaf field placed at \offset are its marker.
+        //! @note  reading a padding byte is not a constant expression, so that a field placed in padding is a hard error.
+        template<typename U, std::size_t N>
+        constexpr bool layout_check_(const std::array<unsigned char, N>& bytes, std::size_t offset, std::size_t& k)noexcept
+        {
+            if constexpr (std::is_array_v<U>) {
+                return layout_check_<std::remove_extent_t<U>>(bytes, offset, k);
+            }
+            else if constexpr (is_std_array_field_<U>::value) {
+                return layout_check_<typename U::value_type>(bytes, offset, k);
             }
-            else if constexpr (nf == 8) {
-                auto& [a0, a1, a2, a3, a4, a5, a6, a7] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else if constexpr (Field == 4)return a4;
-                else if constexpr (Field == 5)return a5;
-                else if constexpr (Field == 6)return a6;
-                else                          return a7;
+            else if constexpr (is_complex_field_<U>::value) {
+                using E = typename U::value_type;
+                return layout_check_<E>(bytes, offset, k) && layout_check_<E>(bytes, offset + sizeof(E), k);
             }
-            else if constexpr (nf == 9) {
-                auto& [a0, a1, a2, a3, a4, a5, a6, a7, a8] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else if constexpr (Field == 4)return a4;
-                else if constexpr (Field == 5)return a5;
-                else if constexpr (Field == 6)return a6;
-                else if constexpr (Field == 7)return a7;
-                else                          return a8;
+            else if constexpr (std::is_same_v<U, bool>) {
+                ++k;
+                return bytes[offset] == 1;
             }
-            else if constexpr (nf == 10) {
-                auto& [a0, a1, a2, a3, a4, a5, a6, a7, a8, a9] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else if constexpr (Field == 4)return a4;
-                else if constexpr (Field == 5)return a5;
-                else if constexpr (Field == 6)return a6;
-                else if constexpr (Field == 7)return a7;
-                else if constexpr (Field == 8)return a8;
-                else                          return a9;
+            else if constexpr (std::is_enum_v<U>) {
+                return layout_check_<std::underlying_type_t<U>>(bytes, offset, k);
             }
-            else if constexpr (nf == 11) {
-                auto& [a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else if constexpr (Field == 4)return a4;
-                else if constexpr (Field == 5)return a5;
-                else if constexpr (Field == 6)return a6;
-                else if constexpr (Field == 7)return a7;
-                else if constexpr (Field == 8)return a8;
-                else if constexpr (Field == 9)return a9;
-                else                          return a10;
+            else if constexpr (std::is_arithmetic_v<U>) {
+                const unsigned char marker = layout_marker_(k++);
+                for (std::size_t i = 0; i < sizeof(U); ++i)
+                    if (bytes[offset + i] != marker)return false;
+                return true;
             }
-            else if constexpr (nf == 12) {
-                auto& [a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11] = data;
-                if      constexpr (Field == 0)return a0;
-                else if constexpr (Field == 1)return a1;
-                else if constexpr (Field == 2)return a2;
-                else if constexpr (Field == 3)return a3;
-                else if constexpr (Field == 4)return a4;
-                else if constexpr (Field == 5)return a5;
-                else if constexpr (Field == 6)return a6;
-                else if constexpr (Field == 7)return a7;
-                else if constexpr (Field == 8)return a8;
-                else if constexpr (Field == 9)return a9;
-                else if constexpr (Field == 10)return a10;
-                else                           return a11;
+            else {
+                return[&]<std::size_t... I>(std::index_sequence<I...>) {
+                    return (layout_check_<field_type_<U, I>>(bytes, offset + field_layout_<U>::offsets[I], k) && ...);
+                }(std::make_index_sequence<num_fields_<U>()>{});
             }
         }
 
-        template<aggregate T, std::size_t Field>
-        inline static auto get_field_offset_()
+        //! @brief whether or not \U has no padding byte, e.g. no field may be placed into it by [[no_unique_address]].
+        //!        The fields of such an aggregate are placed one after another without gap, which is the computed layout,
+        //!        whatever alignas(...) is declared, so that its layout is proved without any instance.
+        template<typename U>
+        consteval bool layout_dense_()noexcept
         {
-            static constexpr T data{};
-            return reinterpret_cast<const char*>(&(get_field_value_<const T, Field>(data))) - reinterpret_cast<const char*>(&data);
+            if constexpr (std::is_array_v<U>)
+                return layout_dense_<std::remove_extent_t<U>>();
+            else if constexpr (is_std_array_field_<U>::value)
+                return layout_dense_<typename U::value_type>() && sizeof(U) == sizeof(typename U::value_type) * std::tuple_size_v<U>;
+            else if constexpr (is_complex_field_<U>::value)
+                return layout_dense_<typename U::value_type>() && sizeof(U) == sizeof(typename U::value_type) * 2;
+            else if constexpr (std::is_scalar_v<U>)
+                return !std::is_same_v<std::remove_cv_t<U>, long double>;
+            else if constexpr (aggregate<U> && !std::is_union_v<U>)
+                return[]<std::size_t... I>(std::index_sequence<I...>) {
+                    return ((sizeof(field_type_<U, I>) + ... + 0) == sizeof(U)) && (layout_dense_<field_type_<U, I>>() && ...);
+                }(std::make_index_sequence<num_fields_<U>()>{});
+            else
+                return std::has_unique_object_representations_v<U>;
         }
 
-        template<aggregate T, typename Visitor, std::size_t Field = 0>
-        inline static void visit_(T& data, Visitor& visitor)
+        //! @brief measure the layout of \T having padding: fill every leaf field of a zero-initialized constexpr value
+        //!        with its marker, std::bit_cast the value to bytes and check the markers at the computed offsets.
+        //! @note  the value is created by std::bit_cast of zero bytes, so that default member initializers are not evaluated.
+        template<aggregate T>
+        consteval bool layout_probe_()noexcept
         {
-            visitor(get_field_value_<T, Field>(data));
-            if constexpr (Field + 1 < num_fields_<T>())
-                visit_<T, Visitor, Field + 1>(data, visitor);
+            if constexpr (layout_dense_<T>()) {
+                return true;
+            }
+            else if constexpr (layout_probeable_<T>()) {
+                T value = std::bit_cast<T>(std::array<unsigned char, sizeof(T)>{});
+                std::size_t k = 0;
+                layout_fill_(value, k);
+                const auto bytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(value);
+                k = 0;
+                return layout_check_<T>(bytes, 0, k);
+            }
+            else {
+                return false; // e.g. a field of pointer or std::string in a struct having padding
+            }
         }
-        template<aggregate T, typename Visitor, std::size_t Field = 0>
-        inline static void visit_(const T& data, Visitor& visitor)
+
+        //! @brief whether or not the computed offsets of \T are proved at compiling time,
+        //!        by layout_dense_ or by layout_probe_ (a field placed in padding makes it not a constant expression).
+        template<typename T>
+        concept layout_supported_ = requires { typename std::bool_constant<layout_probe_<T>()>; } && layout_probe_<T>();
+
+        //! @brief offsets of \T, the struct is rejected if its layout can NOT be proved at compiling time.
+        template<aggregate T>
+        consteval const auto& verified_offsets_()noexcept
         {
-            visitor(get_field_value_<const T, Field>(data));
-            if constexpr (Field + 1 < num_fields_<T>())
-                visit_<T, Visitor, Field + 1>(data, visitor);
+            static_assert(layout_supported_<T>,
+                "memory layout of the struct can NOT be proved, field(s) may be declared with alignas(...) or [[no_unique_address]], "
+                "or the struct has padding and pointer or non trivially copyable field(s)!");
+            return field_layout_<T>::offsets;
         }
 
-        template<aggregate T, std::size_t I>
-        using field_type_ = typename decltype(get_field_type_<T, I>())::type;
+        //! @brief memory layout of all fields, computed at compiling time.
+        //! @note  the offsets are computed by the standard-layout rule: every field is placed
+        //!        at the first address aligned to alignof(field) after the previous one.
+        //!        They are proved at compiling time by verified_offsets_, so that fields declared with alignas(...)
+        //!        or [[no_unique_address]] are rejected.
+
+        template<aggregate T, std::size_t... I>
+        struct field_layout_<T, std::index_sequence<I...>>
+        {
+            inline static constexpr std::array<std::size_t, sizeof...(I)> sizes      = { sizeof(field_type_<T, I>)... };
+            inline static constexpr std::array<std::size_t, sizeof...(I)> alignments = { alignof(field_type_<T, I>)... };
+
+            inline static consteval std::array<std::size_t, sizeof...(I)> get_offsets_()noexcept
+            {
+                std::array<std::size_t, sizeof...(I)> off{};
+                std::size_t pos = 0;
+                for (std::size_t i = 0; i < sizeof...(I); ++i) {
+                    pos = (pos + alignments[i] - 1) / alignments[i] * alignments[i];
+                    off[i] = pos;
+                    pos += sizes[i];
+                }
+                return off;
+            }
+
+            inline static constexpr std::array<std::size_t, sizeof...(I)> offsets = get_offsets_();
+
+            static_assert(sizeof...(I) == 0 || (offsets.back() + sizes.back() + alignof(T) - 1) / alignof(T) * alignof(T) == sizeof(T),
+                "memory layout of the struct is not supported, field(s) may be declared with alignas(...)!");
+        };
     }
 
     template<aggregate T>
@@ -374,8 +424,11 @@ namespace zhb {
             //! @brief Get const reference of the I-th field value.
             inline static auto& get(const T& data)noexcept { return detail::get_field_value_<const T, I>(data); }
 
+            //! @brief memory alignment of this field.
+            inline static constexpr std::size_t alignment = alignof(type);
+
             //! @brief Get offset in bytes of current field.
-            inline static std::size_t offset()noexcept { return detail::get_field_offset_<T, I>(); }
+            inline static constexpr std::size_t offset()noexcept { return detail::verified_offsets_<T>()[I]; }
         };
 
         //! @brief Get reference of the I-th field value.
@@ -388,16 +441,64 @@ namespace zhb {
 
         //! @brief Visit every field. The visitor class should has a template operator().
         template<typename Visitor>
-        inline static void visit(T& data, Visitor& visitor)
+        inline static constexpr void visit(T& data, Visitor&& visitor)
         {
-            detail::visit_<T, Visitor>(data, visitor);
+            detail::visit_<T>(data, visitor);
         }
 
         //! @brief Visit every field. The visitor class should has a template operator().
         template<typename Visitor>
-        inline static void visit(const T& data, Visitor& visitor)
+        inline static constexpr void visit(const T& data, Visitor&& visitor)
+        {
+            detail::visit_<const T>(data, visitor);
+        }
+
+        //! @brief Visit every field with its index, i.e. visitor(field, std::integral_constant<std::size_t, I>{}).
+        template<typename Visitor>
+        inline static constexpr void visit_indexed(T& data, Visitor&& visitor)
+        {
+            detail::visit_indexed_<T>(data, visitor, std::make_index_sequence<num_fields>{});
+        }
+
+        //! @brief Visit every field with its index, i.e. visitor(field, std::integral_constant<std::size_t, I>{}).
+        template<typename Visitor>
+        inline static constexpr void visit_indexed(const T& data, Visitor&& visitor)
+        {
+            detail::visit_indexed_<const T>(data, visitor, std::make_index_sequence<num_fields>{});
+        }
+
+        //! @brief Visit the \index-th field, \index is known at runtime and should be less than \num_fields.
+        //! @return value returned by the visitor, which should be the same type for all fields.
+        template<typename Visitor>
+        inline static constexpr decltype(auto) visit_at(T& data, std::size_t index, Visitor&& visitor)
+        {
+            assert(index < num_fields);
+            return detail::visit_at_<T>(data, index, visitor);
+        }
+
+        //! @brief Visit the \index-th field, \index is known at runtime and should be less than \num_fields.
+        //! @return value returned by the visitor, which should be the same type for all fields.
+        template<typename Visitor>
+        inline static constexpr decltype(auto) visit_at(const T& data, std::size_t index, Visitor&& visitor)
+        {
+            assert(index < num_fields);
+            return detail::visit_at_<const T>(data, index, visitor);
+        }
+
+        //! @brief Visit fields with index until the visitor returns false.
+        //! @return true if all fields are visited.
+        template<typename Visitor>
+        inline static constexpr bool visit_indexed_while(T& data, Visitor&& visitor)
         {
-            detail::visit_<T, Visitor>(data, visitor);
+            return detail::visit_indexed_while_<T>(data, visitor, std::make_index_sequence<num_fields>{});
+        }
+
+        //! @brief Visit fields with index until the visitor returns false.
+        //! @return true if all fields are visited.
+        template<typename Visitor>
+        inline static constexpr bool visit_indexed_while(const T& data, Visitor&& visitor)
+        {
+            return detail::visit_indexed_while_<const T>(data, visitor, std::make_index_sequence<num_fields>{});
         }
     };
 
@@ -415,4 +516,13 @@ namespace zhb {
 
     //! @brief Get type of the I-th field.
     template<aggregate T, std::size_t I> using field_type_t = struct_traits<T>::template field<I>::type;
+
+    //! @brief Get offsets in bytes of all fields.
+    template<aggregate T> constexpr const std::array<std::size_t, num_fields_v<T>>& offsets_v = detail::verified_offsets_<T>();
+
+    //! @brief Get memory sizes of all fields.
+    template<aggregate T> constexpr const std::array<std::size_t, num_fields_v<T>>& sizes_v = detail::field_layout_<T>::sizes;
+
+    //! @brief Get memory alignments of all fields.
+    template<aggregate T> constexpr const std::array<std::size_t, num_fields_v<T>>& alignments_v = detail::field_layout_<T>::alignments;
 }
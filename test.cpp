@@ -1,5 +1,7 @@
 #include <cstddef> // offset_of
 #include <cassert> // assert
+#include <complex>
+#include <cstdint> // int32_t
 #include <iostream>
 #include "struct_traits.hpp"
 
@@ -40,6 +42,59 @@ struct A
     float  a6[2][3]{ 0 };
 };
 
+// an empty struct
+struct E
+{
+};
+
+// a struct with many fields
+struct D
+{
+    int    d0{ 0 },  d1{ 1 },  d2{ 2 },  d3{ 3 },  d4{ 4 },  d5{ 5 },  d6{ 6 },  d7{ 7 },  d8{ 8 },  d9{ 9 };
+    double d10{10}, d11{11}, d12{12}, d13{13}, d14{14}, d15{15}, d16{16}, d17{17}, d18{18}, d19{19};
+    char   d20{'a'}, d21{'b'}, d22{'c'}, d23{'d'}, d24{'e'}, d25{'f'}, d26{'g'}, d27{'h'}, d28{'i'}, d29{'j'};
+    float  d30[4]{ 0 };
+};
+
+// a struct with field having converting constructor from arithmetic type
+struct Z
+{
+    int                 z0{ 0 };
+    std::complex<float> z1{};
+    double              z2[2]{ 0 };
+};
+
+// a struct with large inline array and not constexpr default constructible
+int init_samples() { return 64; }
+struct S
+{
+    int   nsample{ init_samples() };
+    float samples[4096][64];
+    C     info;
+};
+
+// a struct having padding and not constexpr default constructible
+struct P
+{
+    char   p0;
+    double p1{ init_samples() * 0.5 };
+};
+
+// alignas in the middle of the struct: the standard-layout offset of x1 would be 1, the real one is 2
+struct X
+{
+    char            x0;
+    alignas(2) char x1;
+    std::int32_t    x2;
+};
+
+// alignas of the first field does not move the other fields
+struct W
+{
+    alignas(16) double w0;
+    int                w1;
+};
+
 // a visitor class
 struct MyVisitor
 {
@@ -80,6 +135,14 @@ int main()
     constexpr auto nfield_of_A = num_fields_v<A>; // = 7
 
     static_assert(nfield_of_A == 7);
+    static_assert(num_fields_v<B> == 2);
+    static_assert(num_fields_v<E> == 0);
+    static_assert(num_fields_v<D> == 31);
+    static_assert(num_fields_v<Z> == 3);
+    static_assert(std::is_same_v<field_type_t<Z, 1>, std::complex<float>>);
+    static_assert(std::is_same_v<field_type_t<D, 19>, double>);
+    static_assert(std::is_same_v<field_type_t<D, 29>, char>);
+    static_assert(std::is_same_v<field_type_t<D, 30>, float[4]>);
 
     // test field type
     using t0 = field_type_t<A, 0>; // int[3]
@@ -128,6 +191,19 @@ int main()
     static_assert(a0_size == 3);
     static_assert(a3_size == 2);
 
+    // get offsets, sizes and alignments of all fields
+    static_assert(offsets_v<A>[1] == offsetof(A, a1));
+    static_assert(offsets_v<A>[6] == offsetof(A, a6));
+    static_assert(sizes_v<A>[3] == sizeof(B[2]));
+    static_assert(alignments_v<A>[1] == alignof(double));
+    static_assert(struct_traits<A>::field<5>::offset() == offsetof(A, a5));
+    static_assert(!detail::layout_supported_<X>);
+    static_assert(offsets_v<W>[1] == offsetof(W, w1) && struct_traits<W>::field<1>::offset() == offsetof(W, w1));
+    static_assert(offsets_v<P>[1] == offsetof(P, p1));
+    static_assert(offsets_v<D>[30] == offsetof(D, d30));
+    static_assert(std::is_same_v<field_type_t<S, 1>, float[4096][64]>);
+    static_assert(offsets_v<S>[2] == offsetof(S, info));
+
     //--- runtime test
     
     // get offset of field
@@ -157,6 +233,10 @@ int main()
     assert(&a3 == &a.a3);
     assert(&a4 == &a.a4);
 
+    D d;
+    assert(&struct_traits<D>::get<17>(d) == &d.d17);
+    assert(&struct_traits<D>::get<30>(d) == &d.d30);
+
     // test visit
     MyVisitor v;
     struct_traits<A>::visit(a, v);
@@ -167,6 +247,29 @@ int main()
     // 4
     // {5}
     // {{6,7,8},{9,10,11},}
+
+    // test visit with field index
+    std::size_t nbytes = 0;
+    struct_traits<A>::visit_indexed(a, [&](auto& val, auto I) {
+        assert(static_cast<std::size_t>(reinterpret_cast<const char*>(&val) - reinterpret_cast<const char*>(&a)) == offsets_v<A>[I]);
+        nbytes += sizeof(val);
+        });
+    assert(nbytes == 3 * sizeof(int) + sizeof(double) + sizeof(char) + sizeof(B[2]) + sizeof(int) + sizeof(C) + sizeof(float[2][3]));
+
+    // test visit with early exit: stop at the first char field
+    std::size_t nvisited = 0;
+    const bool completed = struct_traits<A>::visit_indexed_while(a, [&nvisited](auto& val, auto) {
+        ++nvisited;
+        return !std::is_same_v<std::remove_cvref_t<decltype(val)>, char>;
+        });
+    assert(!completed && nvisited == 3);
+    struct_traits<E>::visit(E{}, v);
+
+    // test visit the field selected at runtime
+    for (std::size_t i = 0; i < num_fields_v<A>; ++i) {
+        const std::size_t size = struct_traits<A>::visit_at(a, i, [](auto& val) { return sizeof(val); });
+        assert(size == sizes_v<A>[i]);
+    }
     
     return 0;
 }
\ No newline at end of file
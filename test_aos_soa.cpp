@@ -0,0 +1,56 @@
+#include <cassert> // assert
+#include <cstring> // memcmp
+#include <iostream>
+#include <vector>
+#include "aos_soa.hpp"
+
+// a struct with 4-, 8-byte and other fields
+struct P
+{
+    double x;
+    float  y;
+    char   tag;
+    int    ids[3];
+    long long id;
+    short  s;
+};
+
+int main()
+{
+    using namespace zhb;
+
+    constexpr std::size_t n = 1037; // not multiple of any vector length
+    std::vector<P> records(n);
+    for (std::size_t i = 0; i < n; ++i)
+        records[i] = P{ i * 0.5, float(i), char('a' + i % 26), {int(i), int(i + 1), int(i + 2)}, (long long)i << 33, short(i) };
+
+    for (auto level : { simd_level::scalar, simd_level::avx2, simd_level::avx512 }) {
+        if (level > best_simd_level())continue;
+
+        // test AoS -> SoA
+        soa_vector<P> columns;
+        aos_to_soa<P>(records, columns, level);
+        assert(columns.size() == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            assert(columns.column<0>()[i] == records[i].x);
+            assert(columns.column<1>()[i] == records[i].y);
+            assert(columns.column<2>()[i] == records[i].tag);
+            assert(columns.column<3>()[i][2] == records[i].ids[2]);
+            assert(columns.column<4>()[i] == records[i].id);
+            assert(columns.column<5>()[i] == records[i].s);
+        }
+
+        // test SoA -> AoS
+        std::vector<P> back(n);
+        std::memset(back.data(), 0, sizeof(P) * n);
+        soa_to_aos<P>(columns, back, level);
+        for (std::size_t i = 0; i < n; ++i)
+            struct_traits<P>::visit_indexed(back[i], [&](auto& val, auto I) {
+                assert(std::memcmp(&val, &struct_traits<P>::get<I>(records[i]), sizeof(val)) == 0);
+                });
+    }
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <cassert> // assert
+#include <cstddef> // offsetof
+#include <cstdio>  // remove, fopen
+#include <cstring> // memcmp
+#include <iostream>
+#include <vector>
+#include <unistd.h> // sysconf
+#include "column_file.hpp"
+
+// same structs as test.cpp
+struct C { int c0{ 0 }; };
+struct B { int b0{ 0 }; char b1{ '\0' }; };
+struct A
+{
+    int    a0[3]{ 0 };
+    double a1{ 3.0 };
+    char   a2{ '\0' };
+    B      a3[2]{ {0,'\0'},{0,'\0'} };
+    int    a4{ 0 };
+    C      a5{ 0 };
+    float  a6[2][3]{ 0 };
+};
+
+struct Other { double x; int y; };
+
+int main()
+{
+    using namespace zhb;
+
+    const char* path = "test_column_file.bin";
+
+    std::vector<A> a(10000);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const int k = static_cast<int>(i);
+        a[i] = A{ {k,k + 1,k + 2}, k * 0.5, static_cast<char>('A' + k % 26), {{k,'B'},{-k,'C'}}, -k,{k * 2},{{1,2,3},{4,5,static_cast<float>(k)}} };
+    }
+
+    // test every column starts at a multiple of 64 KiB, whatever the page size of the host
+    {
+        detail::column_file_header_ header;
+        detail::column_file_field_  fields[num_fields_v<A>];
+        const bool ok = detail::column_file_layout_<A>::describe(a.size(), header, fields);
+        assert(ok);
+        for (const auto& f : fields)assert(f.column_offset % (64 * 1024) == 0);
+    }
+
+    // test write chunk by chunk
+    {
+        column_file<A>::writer w(path, a.size());
+        w.append(std::span<const A>(a).first(3333));
+        w.append(std::span<const A>(a).subspan(3333));
+        assert(w.size() == a.size());
+    }
+
+    // test read columns
+    {
+        column_file<A>::reader r(path);
+        assert(r.size() == a.size());
+
+        auto a1 = r.column<1>();
+        static_assert(std::is_same_v<decltype(a1), std::span<const double>>);
+        assert(reinterpret_cast<std::uintptr_t>(a1.data()) % static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE)) == 0);
+        for (std::size_t i = 0; i < a.size(); ++i)assert(a1[i] == a[i].a1);
+
+        auto a3 = r.column<3>();
+        static_assert(std::is_same_v<decltype(a3)::element_type, const B[2]>);
+        assert(a3[77][1].b0 == -77 && a3[77][1].b1 == 'C');
+
+        auto a6 = r.column<6>();
+        assert(a6[9999][1][2] == 9999.0f);
+
+        // test read records
+        std::vector<A> b(a.size());
+        r.read(0, b);
+        for (std::size_t i = 0; i < a.size(); ++i)
+            assert(std::memcmp(&a[i].a3, &b[i].a3, sizeof(B) * 2) == 0 && a[i].a1 == b[i].a1 && a[i].a5.c0 == b[i].a5.c0);
+        assert(r[123].a0[2] == 125);
+    }
+
+    // test a writer closed before it is full keeps the appended records, appending too many records throws
+    {
+        column_file<A>::writer w(path, a.size());
+        w.append(std::span<const A>(a).first(100));
+        bool overflow = false;
+        try {
+            w.append(a);
+        }
+        catch (const std::length_error&) {
+            overflow = true;
+        }
+        assert(overflow && w.size() == 100);
+    }
+    {
+        column_file<A>::reader r(path);
+        assert(r.size() == 100 && r.column<6>()[99][1][2] == 99.0f && r[42].a1 == 21.0);
+    }
+
+    // test default constructed reader
+    {
+        column_file<A>::reader r;
+        assert(r.size() == 0 && r.column<1>().empty());
+    }
+
+    // test too many records
+    bool too_large = false;
+    try {
+        column_file<A>::writer w(path, std::size_t(1) << 60);
+    }
+    catch (const std::system_error&) {
+        too_large = true;
+    }
+    assert(too_large);
+
+    // test corrupted number of records, the file size would overflow
+    {
+        column_file<A>::write(path, a);
+        std::FILE* f = std::fopen(path, "r+b");
+        const std::uint64_t n = std::uint64_t(1) << 62;
+        std::fseek(f, offsetof(detail::column_file_header_, num_records), SEEK_SET);
+        std::fwrite(&n, sizeof(n), 1, f);
+        std::fclose(f);
+
+        bool corrupted = false;
+        try {
+            column_file<A>::reader r(path);
+        }
+        catch (const std::system_error&) {
+            corrupted = true;
+        }
+        assert(corrupted);
+    }
+
+    // test layout mismatch
+    bool thrown = false;
+    try {
+        column_file<Other>::reader r(path);
+    }
+    catch (const std::system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // test empty
+    column_file<A>::write(path, {});
+    assert(column_file<A>::reader(path).size() == 0);
+
+    std::remove(path);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <cassert> // assert
+#include <cmath>   // NAN
+#include <cstring> // memset
+#include <iostream>
+#include <string>
+#include <vector>
+#include "compare.hpp"
+
+// a struct having unique object representation
+struct K
+{
+    int       id;
+    unsigned  version;
+    long long key;
+    short     tag[4];
+};
+
+// a struct with padding, floating point and nested fields
+struct B { int b0; char b1; };
+struct P
+{
+    char   c;
+    double x;
+    B      b[2];
+    int    n;
+};
+
+// a struct with non-trivial field
+struct S
+{
+    std::string name;
+    int         n;
+};
+
+int main()
+{
+    using namespace zhb;
+
+    static_assert(std::is_same_v<compare_result_t<K>, std::strong_ordering>);
+    static_assert(std::is_same_v<compare_result_t<P>, std::partial_ordering>);
+    static_assert(std::is_same_v<compare_result_t<S>, std::strong_ordering>);
+
+    // test memcmp path
+    const K k0{ 1, 2, 3, {4, 5, 6, 7} };
+    K k1 = k0;
+    assert(equal(k0, k1) && compare(k0, k1) == 0);
+    k1.tag[2] = -1;
+    assert(!equal(k0, k1));
+    assert(compare(k0, k1) > 0); // compared as short, not as bytes
+    k1 = k0;
+    k1.key = 256;
+    assert(compare(k0, k1) < 0);
+    k1.version = 1;
+    assert(compare(k0, k1) > 0); // version is compared before key
+
+    // test padding bytes are ignored
+    P p1, p2;
+    std::memset(&p1, 0x00, sizeof(P));
+    std::memset(&p2, 0xAB, sizeof(P));
+    for (P* p : { &p1, &p2 }) {
+        p->c = 'c'; p->x = 1.5; p->b[0] = { 1, 'x' }; p->b[1] = { 2, 'y' }; p->n = 3;
+    }
+    assert(equal(p1, p2) && compare(p1, p2) == 0);
+    p2.b[1].b1 = 'z';
+    assert(!equal(p1, p2) && compare(p1, p2) < 0);
+
+    // test IEEE semantics
+    p2 = p1;
+    p1.x = 0.0;
+    p2.x = -0.0;
+    assert(equal(p1, p2) && compare(p1, p2) == 0);
+    p1.x = p2.x = NAN;
+    assert(!equal(p1, p2) && compare(p1, p2) == std::partial_ordering::unordered);
+
+    // test non-trivial field
+    assert((equal(S{ "abc", 1 }, S{ "abc", 1 })));
+    assert((compare(S{ "abc", 2 }, S{ "abd", 1 }) < 0));
+
+    // test find_changed
+    std::vector<K> old(100, k0), now(100, k0);
+    now[3].id = 0;
+    now[64].key = 0;
+    now[99].tag[3] = 0;
+    const auto bitmap = find_changed<K>(old, now);
+    assert(bitmap.size() == 2);
+    assert(bitmap[0] == (std::uint64_t(1) << 3));
+    assert(bitmap[1] == ((std::uint64_t(1) << 0) | (std::uint64_t(1) << 35)));
+
+    std::cout << "OK\n";
+
+    return 0;
+}
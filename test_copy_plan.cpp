@@ -0,0 +1,70 @@
+#include <cassert> // assert
+#include <cstddef> // offsetof
+#include <iostream>
+#include <vector>
+#include "copy_plan.hpp"
+
+// same structs as test.cpp
+struct C { int c0{ 0 }; };
+struct B { int b0{ 0 }; char b1{ '\0' }; };
+struct A
+{
+    int    a0[3]{ 0 };
+    double a1{ 3.0 };
+    char   a2{ '\0' };
+    B      a3[2]{ {0,'\0'},{0,'\0'} };
+    int    a4{ 0 };
+    C      a5{ 0 };
+    float  a6[2][3]{ 0 };
+};
+
+// a struct without padding
+struct V { float x, y, z, w; };
+
+int main()
+{
+    using namespace zhb;
+
+    // test plan of A: {a0}, {a1,a2}, {a3[0]}, {a3[1]}, {a4,a5,a6}, the padding of B is skipped
+    static_assert(copy_plan_v<A>.size() == 5);
+    static_assert(copy_plan_v<A>[0].src_offset == offsetof(A, a0) && copy_plan_v<A>[0].size == sizeof(int[3]));
+    static_assert(copy_plan_v<A>[1].src_offset == offsetof(A, a1) && copy_plan_v<A>[1].dst_offset == sizeof(int[3]));
+    static_assert(copy_plan_v<A>[2].src_offset == offsetof(A, a3) && copy_plan_v<A>[2].size == sizeof(int) + sizeof(char));
+    static_assert(copy_plan_v<A>[3].src_offset == offsetof(A, a3) + sizeof(B) && copy_plan_v<A>[3].size == sizeof(int) + sizeof(char));
+    static_assert(copy_plan_v<A>[4].src_offset == offsetof(A, a4) && copy_plan_v<A>[4].size == offsetof(A, a6) + sizeof(float[2][3]) - offsetof(A, a4));
+    static_assert(packed_size_v<A> == sizeof(A) - 4 - 3 - 3 * 2 - 4); // padding after a0, a2, in a3[0], a3[1] and after a6
+
+    // test plan of V: one block
+    static_assert(copy_plan_v<V>.size() == 1 && packed_size_v<V> == sizeof(V));
+
+    // test pack/unpack
+    const A a{ {0,1,2}, 3.0, 'A', {{1,'B'},{2,'C'}}, 4,{5},{{6,7,8},{9,10,11}} };
+    std::byte buf[packed_size_v<A>];
+    const std::byte* end = pack(a, buf);
+    assert(end == buf + packed_size_v<A>);
+
+    A b;
+    end = unpack(buf, b);
+    assert(end == buf + packed_size_v<A>);
+    assert(b.a0[2] == 2 && b.a1 == 3.0 && b.a2 == 'A' && b.a3[1].b1 == 'C' && b.a4 == 4 && b.a5.c0 == 5 && b.a6[1][2] == 11);
+
+    // test batched pack/unpack
+    std::vector<A> as(10, a), bs(10);
+    for (int i = 0; i < 10; ++i)as[i].a4 = i;
+    std::vector<std::byte> bytes(packed_size_v<A> * as.size());
+    end = pack<A>(as, bytes.data());
+    assert(end == bytes.data() + bytes.size());
+    end = unpack<A>(bytes.data(), bs);
+    assert(end == bytes.data() + bytes.size());
+    for (int i = 0; i < 10; ++i)assert(bs[i].a4 == i && bs[i].a6[1][0] == 9);
+
+    std::vector<V> vs{ {1,2,3,4}, {5,6,7,8} }, ws(2);
+    std::vector<std::byte> vbytes(sizeof(V) * 2);
+    pack<V>(vs, vbytes.data());
+    unpack<V>(vbytes.data(), ws);
+    assert(ws[1].w == 8);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <cassert> // assert
+#include <cstddef> // offsetof
+#include <cstring> // memcmp
+#include <iostream>
+#include <vector>
+#include "delta.hpp"
+
+// same structs as test.cpp
+struct C { int c0{ 0 }; };
+struct B { int b0{ 0 }; char b1{ '\0' }; };
+struct A
+{
+    int    a0[3]{ 0 };
+    double a1{ 3.0 };
+    char   a2{ '\0' };
+    B      a3[2]{ {0,'\0'},{0,'\0'} };
+    int    a4{ 0 };
+    C      a5{ 0 };
+    float  a6[2][3]{ 0 };
+};
+
+int main()
+{
+    using namespace zhb;
+
+    // units: 3 + 1 + 1 + 2 * 2 + 1 + 1 + 6 = 17, i.e. 3 bytes of bitmask, padding bytes are not sent
+    static_assert(detail::delta_layout_<A>::num_units == 17);
+    static_assert(max_patch_size_v<A> == 3 + 63);
+
+    const A old{ {0,1,2}, 3.0, 'A', {{1,'B'},{2,'C'}}, 4,{5},{{6,7,8},{9,10,11}} };
+
+    // test no change
+    std::vector<std::byte> patch;
+    vector_writer writer{ patch };
+    const std::size_t n0 = diff(old, old, writer);
+    assert(n0 == 3 && patch.size() == 3);
+
+    // test different padding bytes inside the nested struct are not changes
+    A padded = old;
+    reinterpret_cast<unsigned char*>(&padded)[offsetof(A, a3) + offsetof(B, b1) + 1] ^= 0x5A;
+    patch.clear();
+    const std::size_t np = diff(old, padded, writer);
+    assert(np == 3);
+
+    // test some changes
+    A now = old;
+    now.a0[1] = -1;
+    now.a0[2] = -2;     // adjacent to a0[1]
+    now.a3[1].b1 = 'Z';
+    now.a6[1][2] = 0.5f;
+    patch.clear();
+    const std::size_t n = diff(old, now, writer);
+    assert(n == patch.size());
+    assert(n == 3 + 2 * sizeof(int) + sizeof(char) + sizeof(float));
+
+    A b = old;
+    const std::byte* end = apply_patch(b, patch.data());
+    assert(end == patch.data() + patch.size());
+    assert(std::memcmp(&b, &now, sizeof(A)) == 0);
+
+    // test all changed
+    A all{ {99,99,99}, 99.0, 'X', {{99,'X'},{99,'X'}}, 99,{99},{{99,99,99},{99,99,99}} };
+    patch.clear();
+    const std::size_t n_all = diff(old, all, writer);
+    assert(n_all == max_patch_size_v<A>);
+    b = old;
+    apply_patch(b, patch.data());
+    assert(b.a1 == 99.0 && b.a3[1].b0 == 99 && b.a6[1][2] == 99);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
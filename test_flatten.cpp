@@ -0,0 +1,64 @@
+#include <array>
+#include <cassert> // assert
+#include <cstddef> // offsetof
+#include <iostream>
+#include "flatten_traits.hpp"
+
+// same structs as test.cpp
+struct C { int c0{ 0 }; };
+struct B { int b0{ 0 }; char b1{ '\0' }; };
+struct A
+{
+    int    a0[3]{ 0 };
+    double a1{ 3.0 };
+    char   a2{ '\0' };
+    B      a3[2]{ {0,'\0'},{0,'\0'} };
+    int    a4{ 0 };
+    C      a5{ 0 };
+    float  a6[2][3]{ 0 };
+};
+
+// deeper nesting with std::array
+struct D
+{
+    A                   a;
+    std::array<C, 2>    c;
+    short               s[2][2];
+};
+
+int main()
+{
+    using namespace zhb;
+
+    using F = flatten_traits<A>;
+    static_assert(F::num_leaves == 10);
+    static_assert(std::is_same_v<F::leaf_type<0>, int>    && F::leaves[0].offset == offsetof(A, a0) && F::leaves[0].count == 3);
+    static_assert(std::is_same_v<F::leaf_type<1>, double> && F::leaves[1].offset == offsetof(A, a1));
+    static_assert(std::is_same_v<F::leaf_type<4>, char>   && F::leaves[4].offset == offsetof(A, a3) + offsetof(B, b1));
+    static_assert(std::is_same_v<F::leaf_type<5>, int>    && F::leaves[5].offset == offsetof(A, a3) + sizeof(B));
+    static_assert(std::is_same_v<F::leaf_type<8>, int>    && F::leaves[8].offset == offsetof(A, a5));
+    static_assert(std::is_same_v<F::leaf_type<9>, float>  && F::leaves[9].offset == offsetof(A, a6) && F::leaves[9].count == 6);
+
+    using G = flatten_traits<D>;
+    static_assert(G::num_leaves == 10 + 2 + 1);
+    static_assert(std::is_same_v<G::leaf_type<11>, int>   && G::leaves[11].offset == offsetof(D, c) + sizeof(C));
+    static_assert(std::is_same_v<G::leaf_type<12>, short> && G::leaves[12].count == 4);
+
+    // test visit_leaves
+    A a{ {0,1,2}, 3.0, 'A', {{1,'B'},{2,'C'}}, 4,{5},{{6,7,8},{9,10,11}} };
+    std::size_t nelem = 0;
+    visit_leaves(a, [&](auto leaf, auto K) {
+        assert(std::size_t(reinterpret_cast<const char*>(leaf.data()) - reinterpret_cast<const char*>(&a)) == F::leaves[K].offset);
+        nelem += leaf.size();
+        });
+    assert(nelem == 3 + 1 + 1 + 4 + 1 + 1 + 6);
+
+    visit_leaves(a, [](auto leaf, auto) {
+        for (auto& v : leaf)v += 1;
+        });
+    assert(a.a0[2] == 3 && a.a3[1].b1 == 'D' && a.a5.c0 == 6 && a.a6[1][2] == 12);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
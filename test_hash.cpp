@@ -0,0 +1,122 @@
+#include <cassert> // assert
+#include <complex>
+#include <cstring> // memset
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "hash.hpp"
+
+// a struct having unique object representation
+struct K
+{
+    int       id;
+    unsigned  version;
+    long long key;
+    char      tag[8];
+
+    bool operator == (const K&)const = default;
+};
+
+// a struct with padding, floating point and nested fields
+struct B { int b0; char b1; };
+struct P
+{
+    char   c;
+    double x;
+    B      b[2];
+    int    n;
+};
+
+// a struct with non-trivial field
+struct S
+{
+    std::string name;
+    int         n;
+};
+
+// a struct with complex field
+struct Z
+{
+    int                  n;
+    std::complex<double> v;
+};
+
+// layouts for the fingerprint
+struct P2 { char c; double y; B b[2]; int m; };     // same layout as P, other names
+struct Q1 { char c; double x; B b[2]; unsigned n; };
+struct Q2 { char c; double x; B b[3]; int n; };
+struct Q3 { char c; double x; std::array<B, 2> b; int n; };
+struct B2 { int b0; short b1; };
+struct Q4 { char c; double x; B2 b[2]; int n; };   // same size as P, nested struct differs
+
+int main()
+{
+    using namespace zhb;
+
+    static_assert(std::has_unique_object_representations_v<K>);
+    static_assert(!std::has_unique_object_representations_v<P>);
+
+    // test unordered_map
+    std::unordered_map<K, int, hash<K>> map;
+    for (int i = 0; i < 100; ++i)
+        map[K{ i, 1u, i * 1000LL, "abc" }] = i;
+    assert(map.size() == 100 && map.at(K{ 42, 1u, 42000LL, "abc" }) == 42);
+
+    // test padding bytes do not change the hash
+    P p1, p2;
+    std::memset(&p1, 0x00, sizeof(P));
+    std::memset(&p2, 0xAB, sizeof(P));
+    for (P* p : { &p1, &p2 }) {
+        p->c = 'c'; p->x = 1.5; p->b[0] = { 1, 'x' }; p->b[1] = { 2, 'y' }; p->n = 3;
+    }
+    assert(hash<P>{}(p1) == hash<P>{}(p2));
+    p2.b[1].b1 = 'z';
+    assert(hash<P>{}(p1) != hash<P>{}(p2));
+
+    // test +0.0 and -0.0
+    p2 = p1;
+    p1.x = 0.0;
+    p2.x = -0.0;
+    assert(hash<P>{}(p1) == hash<P>{}(p2));
+
+    // test non-trivial field
+    assert((hash<S>{}(S{ "abc", 1 }) == hash<S>{}(S{ "abc", 1 })));
+    assert((hash<S>{}(S{ "abc", 1 }) != hash<S>{}(S{ "abd", 1 })));
+
+    // test complex field
+    Z z1{ 1, { 0.0, 2.0 } }, z2{ 1, { -0.0, 2.0 } };
+    assert(hash<Z>{}(z1) == hash<Z>{}(z2));
+    z2.v = { 0.0, 3.0 };
+    assert(hash<Z>{}(z1) != hash<Z>{}(z2));
+
+    // test seed
+    assert((hash<K>{ 1 }(K{}) != hash<K>{ 2 }(K{})));
+
+    // test hash_many gives the same hash as one by one
+    std::vector<K> ks(37);
+    std::vector<P> ps(37, p1);
+    for (int i = 0; i < 37; ++i) {
+        ks[i] = K{ i, 2u, -i, "xyz" };
+        ps[i].n = i;
+    }
+    std::vector<std::uint64_t> hk(ks.size()), hp(ps.size());
+    hash_many<K>(ks, hk.data());
+    hash_many<P>(ps, hp.data());
+    for (int i = 0; i < 37; ++i) {
+        assert(hk[i] == hash<K>{}(ks[i]));
+        assert(hp[i] == hash<P>{}(ps[i]));
+    }
+
+    // test layout fingerprint
+    static_assert(layout_fingerprint_v<P> == layout_fingerprint_v<P2>);
+    static_assert(layout_fingerprint_v<P> == layout_fingerprint_v<Q3>);
+    static_assert(layout_fingerprint_v<P> != layout_fingerprint_v<Q1>);
+    static_assert(layout_fingerprint_v<P> != layout_fingerprint_v<Q2>);
+    static_assert(sizeof(P) == sizeof(Q4) && layout_fingerprint_v<P> != layout_fingerprint_v<Q4>);
+    static_assert(layout_fingerprint_v<K> != layout_fingerprint_v<P>);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <iostream>
+#include "layout_report.hpp"
+
+// a struct with poor field order
+struct Bad
+{
+    char   c0;
+    double d0;
+    char   c1;
+    double d1;
+    short  s0;
+};
+
+// the same fields in optimal order
+struct Good
+{
+    double d0;
+    double d1;
+    short  s0;
+    char   c0;
+    char   c1;
+};
+
+struct E {};
+
+int main()
+{
+    using namespace zhb;
+
+    using R = layout_report<Bad>;
+    static_assert(R::size == 40 && R::field_bytes == 20 && R::padding_bytes == 20);
+    static_assert(R::padding_after[0] == 7 && R::padding_after[2] == 7 && R::padding_after[4] == 6);
+    static_assert(R::optimal_order == std::array<std::size_t, 5>{ 1, 3, 4, 0, 2 });
+    static_assert(R::min_size == sizeof(Good) && R::wasted_bytes == 16);
+
+    static_assert(layout_report<Good>::wasted_bytes == 0);
+    static_assert(layout_report<E>::padding_bytes == 1 && layout_report<E>::wasted_bytes == 0);
+
+    static_assert(!max_padding_v<Bad, 8>);
+    static_assert( max_padding_v<Good, 8>);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <cassert> // assert
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "seqlock.hpp"
+
+struct B { int b0; char b1; };
+struct S
+{
+    long   version;
+    double price[3];
+    char   tag;
+    B      b[2];
+    int    count;
+};
+
+//! @brief every field is derived from \v, so that a torn copy is detected.
+S make(long v)
+{
+    const int i = static_cast<int>(v);
+    return S{ v, {v * 1.0, v * 2.0, v * 3.0}, static_cast<char>('a' + v % 26), {{i,'x'},{-i,'y'}}, i };
+}
+
+bool consistent(const S& s)
+{
+    const S e = make(s.version);
+    return s.price[0] == e.price[0] && s.price[2] == e.price[2] && s.tag == e.tag && s.b[1].b0 == e.b[1].b0 && s.count == e.count;
+}
+
+int main()
+{
+    using namespace zhb;
+
+    // test single thread
+    seqlock<S> state(make(1));
+    assert(consistent(state.load()) && state.load().version == 1);
+
+    state.store<2, 4>('q', 99);
+    S p = state.read<2, 4>();
+    assert(p.tag == 'q' && p.count == 99 && p.version == 0 && p.price[1] == 0.0);
+    assert(state.load().version == 1 && state.load().b[1].b1 == 'y');
+
+    const double price[3] = { 7, 8, 9 };
+    state.store<1>(price);
+    assert(state.read<1>().price[2] == 9);
+
+    state.update<0, 4>([](S& s) {
+        struct_traits<S>::get<0>(s) += 10;
+        struct_traits<S>::get<4>(s) *= 2;
+        });
+    const S q = state.read<0, 4>();
+    assert(q.version == 11 && q.count == 198);
+
+    // test the modifications of a throwing update are not published by later updates
+    try {
+        state.update<4>([](S& s) {
+            struct_traits<S>::get<0>(s) = -1;
+            throw 42;
+            });
+    }
+    catch (int) {
+    }
+    state.update([](S& s) { struct_traits<S>::get<4>(s) = 7; }); // publish the whole struct
+    assert(state.load().version == 11 && state.load().count == 7);
+
+    // test torn-free copies with concurrent writers
+    state.store(make(0));
+    std::atomic<bool> stop{ false }, ok{ true };
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; ++w)
+        threads.emplace_back([&, w] {
+            for (long v = w; v < 20000; v += 2)state.store(make(v));
+            });
+    for (int r = 0; r < 4; ++r)
+        threads.emplace_back([&] {
+            while (!stop.load()) {
+                if (!consistent(state.load()))ok = false;
+                const S s = state.read<0, 4>();
+                if (s.count != static_cast<int>(s.version))ok = false;
+            }
+            });
+    threads[0].join();
+    threads[1].join();
+    stop = true;
+    for (std::size_t i = 2; i < threads.size(); ++i)threads[i].join();
+    assert(ok.load());
+    assert(consistent(state.load()));
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <cassert> // assert
+#include <iostream>
+#include <stdexcept> // length_error
+#include <thread> // yield
+#include <vector>
+#include <sys/wait.h> // waitpid
+#include <unistd.h>   // fork
+#include "shm_ring.hpp"
+
+struct B { int b0; char b1; };
+struct R
+{
+    long   id;
+    double x;
+    B      b[2];
+};
+
+struct Other { long id; double x; int b[4]; };  // same size, different layout
+
+int main()
+{
+    using namespace zhb;
+
+    static_assert(std::has_single_bit(shm_ring<R>::max_capacity));
+    static_assert(shm_ring<R>::max_capacity <= (SIZE_MAX - sizeof(detail::shm_ring_header_)) / sizeof(R));
+
+    const char* name = "/zhb_test_shm_ring";
+    shm_ring<R>::unlink(name);
+
+    // test full, empty and wrap in one process
+    {
+        auto producer = shm_ring<R>::create(name, 5);
+        auto consumer = shm_ring<R>::attach(name);
+        assert(producer.capacity() == 8 && consumer.capacity() == 8);
+
+        bool thrown = false;
+        try {
+            shm_ring<R>::create(name, 8); // exists
+        }
+        catch (const std::system_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            shm_ring<R>::create("/zhb_test_shm_ring_huge", shm_ring<R>::max_capacity + 1); // size overflows size_t
+        }
+        catch (const std::length_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        thrown = false;
+        try {
+            shm_ring<Other>::attach(name);
+        }
+        catch (const std::system_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        std::vector<R> in(20), out(20);
+        for (int i = 0; i < 20; ++i)in[i] = R{ i, i * 0.5, {{i,'a'},{-i,'b'}} };
+
+        assert(consumer.consume(out) == 0);
+        assert(producer.publish(std::span<const R>(in).first(6)) == 6);
+        assert(consumer.consume(std::span<R>(out).first(4)) == 4);
+        assert(producer.publish(std::span<const R>(in).subspan(6)) == 6); // wraps, ring is full
+        assert(producer.size() == 8);
+        assert(producer.publish(std::span<const R>(in).subspan(12)) == 0);
+        assert(consumer.consume(std::span<R>(out).subspan(4)) == 8);
+        for (int i = 0; i < 12; ++i)
+            assert(out[i].id == i && out[i].x == i * 0.5 && out[i].b[1].b0 == -i && out[i].b[1].b1 == 'b');
+    }
+    shm_ring<R>::unlink(name);
+
+    // test producer and consumer in different processes
+    const long n = 1000000;
+    auto producer = shm_ring<R>::create(name, 1024);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        auto consumer = shm_ring<R>::attach(name);
+        std::vector<R> buffer(100);
+        long next = 0;
+        bool ok = true;
+        while (next < n) {
+            const std::size_t m = consumer.consume(buffer);
+            if (m == 0)std::this_thread::yield();
+            for (std::size_t i = 0; i < m; ++i, ++next)
+                ok = ok && buffer[i].id == next && buffer[i].b[0].b0 == static_cast<int>(next);
+        }
+        _exit(ok ? 0 : 1);
+    }
+
+    std::vector<R> batch(64);
+    for (long i = 0; i < n;) {
+        const std::size_t m = std::min<std::size_t>(batch.size(), n - i);
+        for (std::size_t k = 0; k < m; ++k)batch[k] = R{ i + long(k), 0.0, {{int(i + long(k)),'c'},{0,'d'}} };
+        std::span<const R> rest(batch.data(), m);
+        while (!rest.empty()) {
+            const std::size_t published = producer.publish(rest);
+            if (published == 0)std::this_thread::yield();
+            rest = rest.subspan(published);
+        }
+        i += m;
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    shm_ring<R>::unlink(name);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
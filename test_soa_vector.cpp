@@ -0,0 +1,101 @@
+#include <cassert> // assert
+#include <cstdint> // uintptr_t
+#include <iostream>
+#include <limits>
+#include <stdexcept> // length_error
+#include "soa_vector.hpp"
+
+// a struct used to test
+struct P
+{
+    double x{ 0 };
+    char   tag{ '\0' };
+    int    ids[3]{ 0 };
+    float  w{ 1.0f };
+};
+
+// a struct having a field whose type is aligned to more than a cache line
+struct alignas(128) Wide { double w[4]; };
+struct Q
+{
+    int  n;
+    Wide x;
+};
+
+int main()
+{
+    using namespace zhb;
+
+    soa_vector<P> v;
+    assert(v.empty());
+
+    // test push_back and growth
+    for (int i = 0; i < 100; ++i)
+        v.push_back(P{ i * 0.5, char('a' + i % 26), {i, i + 1, i + 2}, float(i) });
+    assert(v.size() == 100 && v.capacity() >= 100);
+
+    // test columns
+    std::span<double> xs = v.column<0>();
+    std::span<float>  ws = v.column<3>();
+    assert(xs.size() == 100 && ws.size() == 100);
+    assert(xs[10] == 5.0 && ws[99] == 99.0f);
+    assert(reinterpret_cast<std::uintptr_t>(xs.data()) % soa_vector<P>::column_alignment == 0);
+    assert(reinterpret_cast<std::uintptr_t>(ws.data()) % soa_vector<P>::column_alignment == 0);
+
+    // test proxy of record
+    auto r = v[42];
+    assert(r.get<1>() == char('a' + 42 % 26));
+    assert(r.get<2>()[2] == 44);
+    r.get<3>() = -1.0f;
+    assert(v.column<3>()[42] == -1.0f);
+
+    P p = v[7];
+    assert(p.x == 3.5 && p.ids[0] == 7 && p.w == 7.0f);
+
+    v[0] = P{ 9.0, 'z', {1, 2, 3}, 2.0f };
+    assert(v.column<0>()[0] == 9.0 && v.column<2>()[0][1] == 2);
+    v[1] = v[0];
+    assert(v.column<1>()[1] == 'z');
+
+    // test reserve/resize keep the data
+    v.reserve(1000);
+    assert(v.capacity() == 1000 && v.column<0>()[10] == 5.0);
+    v.resize(200);
+    assert(v.size() == 200 && v.column<3>()[150] == 1.0f && v.column<2>()[150][0] == 0);
+
+    // test copy and move
+    soa_vector<P> c = v;
+    assert(c.size() == 200 && c.column<0>()[10] == 5.0);
+    soa_vector<P> m = std::move(c);
+    assert(m.size() == 200 && c.empty());
+
+    // test resize_for_overwrite keeps the data and does not fill the new records
+    m.resize_for_overwrite(2000);
+    assert(m.size() == 2000 && m.capacity() == 2000 && m.column<0>()[10] == 5.0);
+    m.resize_for_overwrite(200);
+
+    // test const access
+    const soa_vector<P>& cv = m;
+    std::span<const double> cxs = cv.column<0>();
+    assert(cxs[10] == 5.0);
+    assert(static_cast<P>(cv[10]).x == 5.0);
+
+    // test columns aligned to alignof(field) > column_alignment
+    soa_vector<Q> q(3);
+    static_assert(alignments_v<Q>[1] == 128);
+    assert(reinterpret_cast<std::uintptr_t>(q.column<1>().data()) % 128 == 0);
+
+    // test too many records
+    bool too_many = false;
+    try {
+        q.reserve(std::numeric_limits<std::size_t>::max() / 64);
+    }
+    catch (const std::length_error&) {
+        too_many = true;
+    }
+    assert(too_many && q.size() == 3);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <cassert> // assert
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept> // runtime_error
+#include <vector>
+#include "visit_columns.hpp"
+
+// same structs as test.cpp
+struct C { int c0{ 0 }; };
+struct B { int b0{ 0 }; char b1{ '\0' }; };
+struct A
+{
+    int    a0[3]{ 0 };
+    double a1{ 3.0 };
+    char   a2{ '\0' };
+    B      a3[2]{ {0,'\0'},{0,'\0'} };
+    int    a4{ 0 };
+    C      a5{ 0 };
+    float  a6[2][3]{ 0 };
+};
+
+int main()
+{
+    using namespace zhb;
+
+    std::vector<A> a(1000);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i].a1 = static_cast<double>(i);
+        a[i].a4 = static_cast<int>(i);
+    }
+
+    // test strided view
+    using V1 = column_view_t<A, 1>;
+    static_assert(std::is_same_v<V1::element_type, double> && V1::stride == sizeof(A));
+    static_assert(std::random_access_iterator<V1::iterator>);
+    static_assert(std::is_same_v<column_view_t<const A, 0>::element_type, const int[3]>);
+
+    // test visit every field once
+    std::size_t calls = 0;
+    visit_columns<A>(a, [&](auto column) {
+        ++calls;
+        assert(column.size() == a.size());
+        });
+    assert(calls == num_fields_v<A>);
+
+    // test visit with index
+    visit_columns_indexed<A>(a, [](auto column, auto I) {
+        if constexpr (I == 1) {
+            for (auto& v : column)v *= 2;
+        }
+        else if constexpr (I == 3) {
+            for (auto& v : column)v[1].b1 = 'x';
+        }
+        });
+    for (std::size_t i = 0; i < a.size(); ++i)
+        assert(a[i].a1 == 2.0 * i && a[i].a3[1].b1 == 'x' && a[i].a4 == static_cast<int>(i));
+
+    // test const records and standard algorithms
+    double sum = 0;
+    visit_columns_indexed<const A>(a, [&](auto column, auto I) {
+        if constexpr (I == 1)sum = std::accumulate(column.begin(), column.end(), 0.0);
+        if constexpr (I == 4)assert(std::is_sorted(column.begin(), column.end()) && column.end() - column.begin() == 1000);
+        });
+    assert(sum == 999.0 * 1000);
+
+    // test parallel visit gives the same result
+    std::vector<A> b = a;
+    const auto clamp = [](auto column, auto I) {
+        if constexpr (I == 4) {
+            for (auto& v : column)v = std::min(v, 500);
+        }
+        };
+    visit_columns_indexed<A>(a, clamp);
+    for (std::size_t threads : { 1, 3, 8, 64 }) {
+        std::vector<A> c = b;
+        visit_columns_indexed<A>(c, clamp, threads);
+        for (std::size_t i = 0; i < a.size(); ++i)assert(c[i].a4 == a[i].a4);
+    }
+
+    // test no more threads than requested, e.g. 40961 records of 8 bytes in blocks of 4096 by 10 threads
+    struct R { double r0; };
+    std::vector<R> r(40961);
+    for (std::size_t threads : { 1, 2, 3, 7, 10, 11 }) {
+        std::mutex mutex;
+        std::set<std::thread::id> ids;
+        visit_columns<R>(r, [&](auto) {
+            std::lock_guard lock(mutex);
+            ids.insert(std::this_thread::get_id());
+            }, threads);
+        assert(ids.size() <= threads && ids.count(std::this_thread::get_id()) == 1);
+    }
+
+    // test exceptions of the visitor are rethrown by the calling thread
+    for (std::size_t threads : { 1, 4 }) {
+        std::atomic<std::size_t> calls{ 0 };
+        bool thrown = false;
+        try {
+            visit_columns<R>(r, [&](auto column) {
+                ++calls;
+                if (column.size() == 1)throw std::runtime_error("last block"); // the last block has 1 record
+                }, threads);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && calls == (r.size() + detail::visit_block_size_<R> - 1) / detail::visit_block_size_<R>);
+    }
+
+    // test empty
+    visit_columns<A>(std::span<A>(), [](auto column) { assert(column.empty()); }, 4);
+
+    std::cout << "OK\n";
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+#
+# Check that struct_traits<T>::get<I>() compiles down to a plain member access:
+# the assembly of a function using get<I>() must be identical to the one
+# accessing the member directly (-O2).
+#
+# usage:
+#   python3 tools/check_codegen.py [--cxx g++] [--fields 80]
+#
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+TYPES = ['int', 'double', 'char', 'float', 'long long', 'short']
+
+
+def make_source(nf, indices):
+    lines = ['#include "struct_traits.hpp"', 'struct S {']
+    for i in range(nf):
+        lines.append('    %s f%d;' % (TYPES[i % len(TYPES)], i))
+    lines.append('};')
+    for i in indices:
+        t = TYPES[i % len(TYPES)]
+        lines.append('extern "C" %s load_direct_%d(const S& s) { return s.f%d; }' % (t, i, i))
+        lines.append('extern "C" %s load_traits_%d(const S& s) { return zhb::struct_traits<S>::get<%d>(s); }' % (t, i, i))
+        lines.append('extern "C" void store_direct_%d(S& s, %s v) { s.f%d = v; }' % (i, t, i))
+        lines.append('extern "C" void store_traits_%d(S& s, %s v) { zhb::struct_traits<S>::get<%d>(s) = v; }' % (i, t, i))
+    return '\n'.join(lines) + '\n'
+
+
+def function_bodies(asm):
+    bodies, name = {}, None
+    for line in asm.splitlines():
+        m = re.match(r'^([A-Za-z_]\w*):\s*$', line)
+        if m:
+            name = m.group(1)
+            bodies[name] = []
+            continue
+        s = line.strip()
+        if name is None or not s or s.startswith('.') or s.startswith('#'):
+            continue
+        bodies[name].append(s)
+    return bodies
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument('--cxx', default=os.environ.get('CXX', 'g++'))
+    ap.add_argument('--fields', type=int, default=80)
+    args = ap.parse_args()
+
+    nf = args.fields
+    indices = sorted({0, 1, nf // 2, nf - 2, nf - 1})
+
+    with tempfile.TemporaryDirectory() as tmp:
+        src = os.path.join(tmp, 'codegen.cpp')
+        asm = os.path.join(tmp, 'codegen.s')
+        with open(src, 'w') as f:
+            f.write(make_source(nf, indices))
+        subprocess.run([args.cxx, '-std=c++20', '-O2', '-S', '-fno-asynchronous-unwind-tables',
+                        '-I', ROOT, src, '-o', asm], check=True)
+        with open(asm) as f:
+            bodies = function_bodies(f.read())
+
+    failed = 0
+    for i in indices:
+        for op in ('load', 'store'):
+            direct = bodies.get('%s_direct_%d' % (op, i))
+            traits = bodies.get('%s_traits_%d' % (op, i))
+            ok = direct is not None and direct == traits
+            print('%-5s field %3d: %s' % (op, i, 'OK' if ok else 'MISMATCH'))
+            if not ok:
+                failed += 1
+                print('  direct:', direct)
+                print('  traits:', traits)
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+#
+# Generate struct_traits_bindings.hpp: structured bindings of aggregates
+# with 1..MAX fields used by struct_traits.hpp.
+#
+# usage:
+#   python3 tools/gen_bindings.py [--max 256] [--out struct_traits_bindings.hpp]
+#
+
+import argparse
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+HEAD = '''\
+//! @brief   Structured bindings of aggregates with 1 to {max} fields.
+//! @note    This file is generated by tools/gen_bindings.py, do NOT edit it!
+//!          Regenerate it by:
+//!            python3 tools/gen_bindings.py --max {max}
+//!
+
+#pragma once
+#include <cstddef>
+
+namespace zhb {{
+    namespace detail
+    {{
+        //! @brief maximum number of fields supported.
+        inline constexpr std::size_t max_num_fields_ = {max};
+
+        //! @brief bind all the \\N fields of \\data and pass references of them to \\f.
+        //! @return the value returned by \\f.
+        template<std::size_t N, typename T, typename F>
+        constexpr decltype(auto) bind_fields_(T& data, F&& f)
+        {{
+            static_assert(N <= max_num_fields_, "field number is more than {max}, regenerate struct_traits_bindings.hpp!");
+
+            if constexpr (N == 0) {{
+                return f();
+            }}
+'''
+
+TAIL = '''\
+        }
+    }
+}
+'''
+
+PER_LINE = 16
+
+
+def names(n, indent):
+    ids = ['a%d' % i for i in range(n)]
+    lines = [', '.join(ids[i:i + PER_LINE]) for i in range(0, n, PER_LINE)]
+    return (',\n' + indent).join(lines)
+
+
+def case(n):
+    ind = ' ' * 16
+    if n <= PER_LINE:
+        return ('            else if constexpr (N == {n}) {{\n'
+                '                auto& [{a}] = data;\n'
+                '                return f({a});\n'
+                '            }}\n').format(n=n, a=names(n, ''))
+    return ('            else if constexpr (N == {n}) {{\n'
+            '                auto& [\n'
+            '                    {a}\n'
+            '                ] = data;\n'
+            '                return f(\n'
+            '                    {a}\n'
+            '                );\n'
+            '            }}\n').format(n=n, a=names(n, ind + '    '))
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument('--max', type=int, default=256)
+    ap.add_argument('--out', default=os.path.join(ROOT, 'struct_traits_bindings.hpp'))
+    args = ap.parse_args()
+
+    with open(args.out, 'w', newline='\n') as f:
+        f.write(HEAD.format(max=args.max))
+        for n in range(1, args.max + 1):
+            f.write(case(n))
+        f.write(TAIL)
+
+
+if __name__ == '__main__':
+    main()
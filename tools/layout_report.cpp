@@ -0,0 +1,80 @@
+//!
+//! @brief   Print padding report of structs, used to enforce tight layouts in CI.
+//!
+//! build:
+//!   g++ -std=c++20 -I.. layout_report.cpp -o layout_report
+//! usage:
+//!   layout_report [--max-padding N]
+//!     exit with 1 if any struct has more than N padding bytes.
+//!
+//! Add your own structs to the list in main().
+//!
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../layout_report.hpp"
+
+// structs in test.cpp
+struct C { int c0; };
+struct B { int b0; char b1; };
+struct A
+{
+    int    a0[3];
+    double a1;
+    char   a2;
+    B      a3[2];
+    int    a4;
+    C      a5;
+    float  a6[2][3];
+};
+
+// a struct with poor field order
+struct Bad
+{
+    char   c0;
+    double d0;
+    char   c1;
+    double d1;
+    short  s0;
+};
+
+template<typename T>
+bool report(const char* name, std::size_t max_padding)
+{
+    using R = zhb::layout_report<T>;
+
+    std::printf("%s: size=%zu, fields=%zu bytes, padding=%zu bytes, min size=%zu (%zu bytes saved by reordering)\n",
+        name, R::size, R::field_bytes, R::padding_bytes, R::min_size, R::wasted_bytes);
+    for (std::size_t i = 0; i < R::num_fields; ++i)
+        std::printf("  field %2zu: offset=%4zu size=%4zu align=%2zu padding after=%zu\n",
+            i, zhb::offsets_v<T>[i], zhb::sizes_v<T>[i], zhb::alignments_v<T>[i], R::padding_after[i]);
+    std::printf("  optimal order:");
+    for (auto i : R::optimal_order)std::printf(" %zu", i);
+    std::printf("\n");
+
+    if (R::padding_bytes > max_padding) {
+        std::printf("  ERROR: %zu padding bytes is more than %zu\n", R::padding_bytes, max_padding);
+        return false;
+    }
+    return true;
+}
+
+#define REPORT(T) ok = report<T>(#T, max_padding) && ok
+
+int main(int argc, char** argv)
+{
+    std::size_t max_padding = static_cast<std::size_t>(-1);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--max-padding") == 0 && i + 1 < argc)
+            max_padding = std::strtoull(argv[++i], nullptr, 10);
+    }
+
+    bool ok = true;
+    REPORT(A);
+    REPORT(B);
+    REPORT(C);
+    REPORT(Bad);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+//!
+//! @brief   Visit every field of a span of records as a strided column.
+//! @author  ZHANG Bing, zhangbing@hfut.edu.cn
+//! @date    2026-10-16
+//! @version 0.1
+//!
+//! struct_traits<T>::visit calls the visitor once per field of one record, visit_columns calls it once per field
+//! of all the records, with a strided view of the field:
+//!
+//!   zhb::visit_columns<A>(records, [](auto column) {
+//!       for (auto& v : column)v = byte_swap(v);   // stride is sizeof(A) at compile time, the loop may be vectorized
+//!   });
+//!
+//! Every column of a large span is read from memory separately. The overload taking the number of threads splits
+//! the records into contiguous chunks, one per thread, and visits each chunk in cache-sized blocks, so the records
+//! are read from memory once. The visitor is called concurrently on different records, it should be thread safe.
+//!
+
+#pragma once
+#include <algorithm>  // min
+#include <cstddef>    // byte, ptrdiff_t
+#include <exception>  // exception_ptr
+#include <iterator>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "struct_traits.hpp"
+
+namespace zhb {
+
+    //! @brief View of \size() objects of type \U placed every \Stride bytes, e.g. one field of an array of records.
+    template<typename U, std::size_t Stride>
+    class strided_span
+    {
+        using byte_type = std::conditional_t<std::is_const_v<U>, const std::byte, std::byte>;
+
+    public:
+        using element_type = U;
+        using value_type   = std::remove_cv_t<U>;
+        using size_type    = std::size_t;
+
+        inline static constexpr std::size_t stride = Stride;
+
+        //! @brief random access iterator.
+        class iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = std::remove_cv_t<U>;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = U*;
+            using reference         = U&;
+
+            iterator() = default;
+            explicit iterator(byte_type* p)noexcept : p_(p) {}
+
+            reference operator * ()const noexcept { return *reinterpret_cast<U*>(p_); }
+            pointer operator -> ()const noexcept { return reinterpret_cast<U*>(p_); }
+            reference operator [] (difference_type i)const noexcept { return *(*this + i); }
+
+            iterator& operator ++ ()noexcept { p_ += Stride; return *this; }
+            iterator& operator -- ()noexcept { p_ -= Stride; return *this; }
+            iterator operator ++ (int)noexcept { iterator it = *this; p_ += Stride; return it; }
+            iterator operator -- (int)noexcept { iterator it = *this; p_ -= Stride; return it; }
+            iterator& operator += (difference_type n)noexcept { p_ += n * static_cast<difference_type>(Stride); return *this; }
+            iterator& operator -= (difference_type n)noexcept { p_ -= n * static_cast<difference_type>(Stride); return *this; }
+
+            friend iterator operator + (iterator it, difference_type n)noexcept { return it += n; }
+            friend iterator operator + (difference_type n, iterator it)noexcept { return it += n; }
+            friend iterator operator - (iterator it, difference_type n)noexcept { return it -= n; }
+            friend difference_type operator - (iterator a, iterator b)noexcept { return (a.p_ - b.p_) / static_cast<difference_type>(Stride); }
+
+            friend bool operator == (iterator a, iterator b)noexcept { return a.p_ == b.p_; }
+            friend auto operator <=> (iterator a, iterator b)noexcept { return a.p_ <=> b.p_; }
+
+        private:
+            byte_type* p_ = nullptr;
+        };
+
+        strided_span() = default;
+        strided_span(U* first, std::size_t size)noexcept : data_(reinterpret_cast<byte_type*>(first)), size_(size) {}
+
+        U& operator [] (std::size_t i)const noexcept
+        {
+            assert(i < size_);
+            return *reinterpret_cast<U*>(data_ + i * Stride);
+        }
+
+        std::size_t size()const noexcept { return size_; }
+        bool empty()const noexcept { return size_ == 0; }
+
+        iterator begin()const noexcept { return iterator(data_); }
+        iterator end()const noexcept { return iterator(data_ + size_ * Stride); }
+
+    private:
+        byte_type*  data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    //! @brief strided view of the I-th field of \records.
+    template<aggregate T, std::size_t I>
+    using column_view_t = strided_span<std::conditional_t<std::is_const_v<T>, const field_type_t<std::remove_const_t<T>, I>, field_type_t<std::remove_const_t<T>, I>>, sizeof(T)>;
+
+    namespace detail
+    {
+        template<aggregate T, std::size_t I>
+        inline column_view_t<T, I> column_view_(std::span<T> records)noexcept
+        {
+            using U = typename column_view_t<T, I>::element_type;
+            using byte_type = std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+            const auto p = reinterpret_cast<byte_type*>(records.data()) + offsets_v<std::remove_const_t<T>>[I];
+            return { reinterpret_cast<U*>(p), records.size() };
+        }
+
+        template<aggregate T, typename Visitor, std::size_t... I>
+        inline void visit_columns_(std::span<T> records, Visitor& visitor, std::index_sequence<I...>)
+        {
+            (visitor(column_view_<T, I>(records)), ...);
+        }
+
+        template<aggregate T, typename Visitor, std::size_t... I>
+        inline void visit_columns_indexed_(std::span<T> records, Visitor& visitor, std::index_sequence<I...>)
+        {
+            (visitor(column_view_<T, I>(records), std::integral_constant<std::size_t, I>{}), ...);
+        }
+
+        //! @brief number of records of a block visited by one thread, a block of 32 KB stays in L1/L2 cache
+        //!        while all of its columns are visited.
+        template<typename T>
+        inline constexpr std::size_t visit_block_size_ = std::max<std::size_t>(64, (32 * 1024 / sizeof(T)) / 64 * 64);
+
+        //! @brief split \records into at most \num_threads chunks, each chunk is split into blocks and \f(block) is called
+        //!        in parallel, the calling thread takes the first chunk. The first exception thrown by \f is rethrown
+        //!        after all the threads are joined.
+        template<aggregate T, typename F>
+        inline void for_each_block_(std::span<T> records, std::size_t num_threads, F&& f)
+        {
+            const auto visit_chunk = [&f](std::span<T> chunk) {
+                for (std::size_t first = 0; first < chunk.size(); first += visit_block_size_<T>)
+                    f(chunk.subspan(first, std::min(visit_block_size_<T>, chunk.size() - first)));
+                };
+
+            constexpr std::size_t block = visit_block_size_<T>;
+            num_threads = std::max<std::size_t>(1, std::min(num_threads, (records.size() + block - 1) / block));
+            // round ceil(size / num_threads) up to blocks, so that there are at most num_threads chunks
+            const std::size_t chunk = ((records.size() + num_threads - 1) / num_threads + block - 1) / block * block;
+
+            std::vector<std::exception_ptr> errors(num_threads);
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(num_threads - 1);
+                for (std::size_t first = chunk, t = 1; first < records.size(); first += chunk, ++t)
+                    threads.emplace_back([=, &visit_chunk, &errors] {
+                        try {
+                            visit_chunk(records.subspan(first, std::min(chunk, records.size() - first)));
+                        }
+                        catch (...) {
+                            errors[t] = std::current_exception();
+                        }
+                        });
+                try {
+                    visit_chunk(records.first(std::min(chunk, records.size())));
+                }
+                catch (...) {
+                    errors[0] = std::current_exception();
+                }
+            } // join
+            for (const auto& e : errors)
+                if (e)std::rethrow_exception(e);
+        }
+    }
+
+    //! @brief Visit every field of all the records, i.e. visitor(column) once per field,
+    //!        column is a strided_span of the field in all the records.
+    template<aggregate T, typename Visitor>
+    inline void visit_columns(std::type_identity_t<std::span<T>> records, Visitor&& visitor)
+    {
+        detail::visit_columns_<T>(records, visitor, std::make_index_sequence<num_fields_v<std::remove_const_t<T>>>{});
+    }
+
+    //! @brief Visit every field of all the records with its index, i.e. visitor(column, std::integral_constant<std::size_t, I>{}).
+    template<aggregate T, typename Visitor>
+    inline void visit_columns_indexed(std::type_identity_t<std::span<T>> records, Visitor&& visitor)
+    {
+        detail::visit_columns_indexed_<T>(records, visitor, std::make_index_sequence<num_fields_v<std::remove_const_t<T>>>{});
+    }
+
+    //! @brief Visit every field of all the records by \num_threads threads, each thread visits a contiguous chunk of records
+    //!        block by block, so that a block is read from memory once for all of its columns.
+    //! @note  the visitor is called once per field and block, concurrently on different chunks.
+    template<aggregate T, typename Visitor>
+    inline void visit_columns(std::type_identity_t<std::span<T>> records, Visitor&& visitor, std::size_t num_threads)
+    {
+        detail::for_each_block_<T>(records, num_threads, [&visitor](std::span<T> chunk) { visit_columns<T>(chunk, visitor); });
+    }
+
+    //! @brief Visit every field of all the records with its index by \num_threads threads, block by block.
+    //! @note  the visitor is called once per field and block, concurrently on different chunks.
+    template<aggregate T, typename Visitor>
+    inline void visit_columns_indexed(std::type_identity_t<std::span<T>> records, Visitor&& visitor, std::size_t num_threads)
+    {
+        detail::for_each_block_<T>(records, num_threads, [&visitor](std::span<T> chunk) { visit_columns_indexed<T>(chunk, visitor); });
+    }
+}